@@ -0,0 +1,151 @@
+/*
+  Medición del despacho de comandos del intérprete.
+
+  Se reproduce un guion de comandos (generado o leído de un archivo) y se mide
+  cuánto cuesta encontrar cada comando con la tabla de dispersión de
+  'interprete' y con la cadena de 'strcmp' que usaba 'principal.cpp', en su
+  orden original.
+
+  Uso:
+    despacho [lineas [semilla]]   genera un guion de 'lineas' comandos
+    despacho archivo.in           reproduce los comandos de 'archivo.in'
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/interprete.h"
+#include "../include/utils.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+// orden en el que 'principal.cpp' comparaba los nombres
+static const char *cadenaOriginal[] = {
+    "Fin", "#", "esLocalizador", "esVaciaCadena", "inicioCadena",
+    "finalCadena", "infoCadena", "esFinalCadena", "esInicioCadena",
+    "siguiente", "anterior", "insertarAlFinal", "insertarAntes",
+    "removerDeCadena", "imprimirCadena", "kesimo", "localizadorEnCadena",
+    "precedeEnCadena", "insertarSegmentoDespues", "copiarSegmento",
+    "borrarSegmento", "cambiarEnCadena", "intercambiar", "siguienteClave",
+    "anteriorClave", "menorEnCadena", "pertenece", "longitud",
+    "estaOrdenadaPorNaturales", "hayNatsRepetidos", "sonIgualesCadena",
+    "concatenar", "ordenar", "cambiarTodos", "subCadena", "guardarCadena",
+    "cargarCadena", "reiniciar"};
+static const nat CANT_ORIGINAL = sizeof(cadenaOriginal) / sizeof(char *);
+
+/*
+  Devuelve la posición (desde 1) de 'nombre' en 'cadenaOriginal', o 0.
+*/
+static nat buscarEnCadena(const char *nombre) {
+  nat i = 0;
+  while ((i < CANT_ORIGINAL) && strcmp(nombre, cadenaOriginal[i]))
+    i++;
+  return (i < CANT_ORIGINAL) ? i + 1 : 0;
+}
+
+static double segundos() {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/*
+  Devuelve el guion como texto, una línea por comando.
+*/
+static std::string generarGuion(nat lineas, nat semilla) {
+  std::string guion;
+  srand(semilla);
+  for (nat i = 0; i < lineas; i++) {
+    guion += cadenaOriginal[rand() % CANT_ORIGINAL];
+    guion += " 1 2\n";
+  }
+  return guion;
+}
+
+static bool leerArchivo(const char *archivo, std::string &guion) {
+  FILE *f = fopen(archivo, "rb");
+  if (f == NULL)
+    return false;
+  char tampon[1 << 16];
+  size_t leidos;
+  while ((leidos = fread(tampon, 1, sizeof(tampon), f)) > 0)
+    guion.append(tampon, leidos);
+  fclose(f);
+  return true;
+}
+
+/*
+  Separa el primer nombre de cada línea de 'guion'. Los nombres quedan
+  terminados con '\0' dentro de 'guion'.
+*/
+static std::vector<const char *> separarNombres(std::string &guion) {
+  std::vector<const char *> nombres;
+  char *p = &guion[0];
+  char *fin = p + guion.size();
+  while (p < fin) {
+    while ((p < fin) && isspace((unsigned char)*p))
+      p++;
+    char *ini = p;
+    while ((p < fin) && !isspace((unsigned char)*p))
+      p++;
+    bool finLinea = (p == fin) || (*p == '\n');
+    if (p > ini) {
+      if (p < fin)
+        *p++ = '\0';
+      nombres.push_back(ini);
+    }
+    if (!finLinea) {
+      while ((p < fin) && (*p != '\n'))
+        p++;
+    }
+  }
+  return nombres;
+}
+
+int main(int argc, char *argv[]) {
+  std::string guion;
+  if ((argc > 1) && !isdigit((unsigned char)argv[1][0])) {
+    if (!leerArchivo(argv[1], guion)) {
+      fprintf(stderr, "No se pudo leer %s.\n", argv[1]);
+      return 1;
+    }
+  } else {
+    nat lineas = (argc > 1) ? atoi(argv[1]) : 4000000;
+    nat semilla = (argc > 2) ? atoi(argv[2]) : 1;
+    guion = generarGuion(lineas, semilla);
+  }
+  std::vector<const char *> nombres = separarNombres(guion);
+  size_t n = nombres.size();
+  if (n == 0) {
+    fprintf(stderr, "El guion no tiene comandos.\n");
+    return 1;
+  }
+
+  // los resultados se acumulan para que no se descarten las búsquedas
+  unsigned long controlCadena = 0, controlTabla = 0;
+
+  double t0 = segundos();
+  for (size_t i = 0; i < n; i++)
+    controlCadena += buscarEnCadena(nombres[i]);
+  double t1 = segundos();
+  for (size_t i = 0; i < n; i++)
+    controlTabla += buscarComando(nombres[i]);
+  double t2 = segundos();
+
+  double nsCadena = (t1 - t0) * 1e9 / n;
+  double nsTabla = (t2 - t1) * 1e9 / n;
+  printf("comandos: %zu\n", n);
+  printf("cadena de strcmp: %.2f ns/comando (control %lu)\n", nsCadena,
+         controlCadena);
+  printf("tabla:            %.2f ns/comando (control %lu)\n", nsTabla,
+         controlTabla);
+  printf("mejora: %.2fx\n", nsCadena / nsTabla);
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*
+  Ejecutor de guiones de comandos.
+
+  Ejecuta 'programa --lote' con el guion como entrada estándar, descartando
+  la salida, e informa cuántos comandos por segundo procesó y el máximo de
+  memoria residente (RSS) que usó. Se cuenta un comando por cada línea del
+  guion que no está en blanco.
+
+  Uso:
+    ejecutor guion.in [programa]
+  Por defecto 'programa' es './principal'.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/utils.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static double segundos() {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/*
+  Devuelve la cantidad de líneas de 'fd' que tienen algún carácter distinto
+  de espacio, y deja 'fd' al principio.
+*/
+static nat contarComandos(int fd) {
+  static char tampon[1 << 16];
+  nat res = 0;
+  bool enBlanco = true;
+  ssize_t leidos;
+  while ((leidos = read(fd, tampon, sizeof(tampon))) > 0) {
+    for (ssize_t i = 0; i < leidos; i++) {
+      char c = tampon[i];
+      if (c == '\n') {
+        res += !enBlanco;
+        enBlanco = true;
+      } else if ((c != ' ') && (c != '\t') && (c != '\r')) {
+        enBlanco = false;
+      }
+    }
+  }
+  res += !enBlanco;
+  lseek(fd, 0, SEEK_SET);
+  return res;
+}
+
+int main(int argc, char *argv[]) {
+  if ((argc < 2) || (argc > 3)) {
+    fprintf(stderr, "Uso: %s guion.in [programa]\n", argv[0]);
+    return 1;
+  }
+  const char *guion = argv[1];
+  const char *programa = (argc > 2) ? argv[2] : "./principal";
+
+  int entrada = open(guion, O_RDONLY);
+  if (entrada < 0) {
+    fprintf(stderr, "No se pudo abrir %s.\n", guion);
+    return 1;
+  }
+  nat comandos = contarComandos(entrada);
+
+  double inicio = segundos();
+  pid_t hijo = fork();
+  if (hijo == 0) {
+    int nula = open("/dev/null", O_WRONLY);
+    dup2(entrada, STDIN_FILENO);
+    dup2(nula, STDOUT_FILENO);
+    execl(programa, programa, "--lote", (char *)NULL);
+    fprintf(stderr, "No se pudo ejecutar %s.\n", programa);
+    _exit(127);
+  }
+  int estado;
+  rusage uso;
+  bool ok = (hijo > 0) && (wait4(hijo, &estado, 0, &uso) == hijo);
+  double duracion = segundos() - inicio;
+  close(entrada);
+  if (!ok || !WIFEXITED(estado) || (WEXITSTATUS(estado) != 0)) {
+    fprintf(stderr, "%s no terminó normalmente.\n", programa);
+    return 1;
+  }
+
+  printf("guion: %s\n", guion);
+  printf("comandos: %u\n", comandos);
+  printf("segundos: %.3f\n", duracion);
+  printf("comandos por segundo: %.0f\n", comandos / duracion);
+  // en Linux 'ru_maxrss' está en KiB
+  printf("RSS máximo: %ld KiB\n", uso.ru_maxrss);
+  return 0;
+}
@@ -0,0 +1,565 @@
+/*
+  Generador de guiones de comandos para 'principal'.
+
+  Se imprime en la salida estándar un guion de 'lineas' comandos elegidos al
+  azar (con la semilla dada) según los pesos de una mezcla. El generador
+  mantiene un modelo de 'cad' y 'loc' y solo emite comandos cuyas
+  precondiciones se cumplen, por lo que el guion se puede ejecutar con o sin
+  'assert'. Los naturales de 'cad' no se repiten.
+
+  Mezclas predefinidas:
+    agregado      mayormente insertarAlFinal
+    posicional    kesimo, infoCadena, siguiente, anterior, intercambiar
+    busqueda      pertenece, siguienteClave, anteriorClave, menorEnCadena
+    ordenamiento  ordenar, subCadena, estaOrdenadaPorNaturales
+    mixta         todos los comandos
+  Con '--pesos' se da una mezcla propia, por ejemplo
+  '--pesos insertarAlFinal=70,kesimo=30'.
+
+  Antes de la mezcla se insertan '--inicial' elementos. Cuando 'cad' llega a
+  '--maximo' elementos no se eligen comandos que la hagan crecer.
+
+  Uso:
+    generador [--mezcla NOMBRE | --pesos LISTA] [--lineas N] [--semilla S]
+              [--inicial N] [--maximo N]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// Naturales menores que este tope (los de 'cad' se eligen al azar).
+#define TOPE_CLAVES 1000000000
+// Largo máximo de los segmentos que se copian, borran o insertan.
+#define MAX_SEGMENTO 50
+
+struct modelo {
+  std::vector<nat> claves; // los naturales de 'cad', en orden
+  std::unordered_set<nat> presentes;
+  long loc; // posición (desde 0) de 'loc' en 'cad', o -1 si no es válido
+  bool ordenada; // si se sabe que 'cad' está ordenada
+  nat maximo;
+  std::mt19937_64 azar;
+};
+
+/*
+  Devuelve un número al azar entre 'menor' y 'mayor', inclusive.
+*/
+static nat entre(nat menor, nat mayor, modelo &m) {
+  return std::uniform_int_distribution<nat>(menor, mayor)(m.azar);
+}
+
+static bool locValido(const modelo &m) { return m.loc >= 0; }
+
+/*
+  Devuelve un natural que no está en 'cad'.
+*/
+static nat claveNueva(modelo &m) {
+  nat c;
+  do {
+    c = entre(0, TOPE_CLAVES - 1, m);
+  } while (m.presentes.count(c) > 0);
+  return c;
+}
+
+/*
+  Devuelve un natural de 'cad' o, si 'cad' es vacía o con probabilidad 1/2,
+  uno que no está.
+*/
+static nat claveBuscada(modelo &m) {
+  if (m.claves.empty() || (entre(0, 1, m) == 0))
+    return claveNueva(m);
+  return m.claves[entre(0, m.claves.size() - 1, m)];
+}
+
+static void imprimirInfo(nat natural, modelo &m) {
+  printf(" (%u,%u.%02u)", natural, entre(0, 999, m), entre(0, 99, m));
+}
+
+/*
+  Imprime una cadena de 'cant' elementos nuevos (que no se agregan a 'cad') y
+  devuelve sus naturales.
+*/
+static std::vector<nat> imprimirCadenaNueva(nat cant, modelo &m) {
+  std::vector<nat> res;
+  printf(" %u", cant);
+  for (nat i = 0; i < cant; i++) {
+    nat c = claveNueva(m);
+    // no se repiten dentro de la cadena leída
+    while (std::find(res.begin(), res.end(), c) != res.end())
+      c = claveNueva(m);
+    res.push_back(c);
+    imprimirInfo(c, m);
+  }
+  return res;
+}
+
+static void agregarClave(nat pos, nat c, modelo &m) {
+  m.claves.insert(m.claves.begin() + pos, c);
+  m.presentes.insert(c);
+}
+
+/*
+  Quita de 'cad' los elementos de las posiciones 'desde' .. 'hasta'. Si
+  'loc' estaba entre ellos deja de ser válido.
+*/
+static void quitarClaves(nat desde, nat hasta, modelo &m) {
+  for (nat i = desde; i <= hasta; i++)
+    m.presentes.erase(m.claves[i]);
+  m.claves.erase(m.claves.begin() + desde, m.claves.begin() + hasta + 1);
+  if (m.loc > (long)hasta)
+    m.loc -= hasta - desde + 1;
+  else if (m.loc >= (long)desde)
+    m.loc = -1;
+}
+
+// --------------------------------------------------------------------
+// Generadores de cada comando. Devuelven 'false' si en el estado actual no
+// se puede emitir el comando.
+
+static bool genInsertarAlFinal(modelo &m) {
+  if (m.claves.size() >= m.maximo)
+    return false;
+  nat c = claveNueva(m);
+  m.ordenada = m.ordenada && (m.claves.empty() || (c > m.claves.back()));
+  printf("insertarAlFinal");
+  imprimirInfo(c, m);
+  agregarClave(m.claves.size(), c, m);
+  return true;
+}
+
+static bool genInsertarAntes(modelo &m) {
+  if (!locValido(m) || (m.claves.size() >= m.maximo))
+    return false;
+  nat c = claveNueva(m);
+  m.ordenada = false;
+  printf("insertarAntes");
+  imprimirInfo(c, m);
+  agregarClave(m.loc, c, m);
+  m.loc++;
+  return true;
+}
+
+static bool genInsertarSegmentoDespues(modelo &m) {
+  if ((!m.claves.empty() && !locValido(m)) ||
+      (m.claves.size() + MAX_SEGMENTO > m.maximo))
+    return false;
+  printf("insertarSegmentoDespues");
+  std::vector<nat> sgm = imprimirCadenaNueva(entre(0, MAX_SEGMENTO, m), m);
+  nat pos = m.claves.empty() ? 0 : m.loc + 1;
+  for (nat i = 0; i < sgm.size(); i++)
+    agregarClave(pos + i, sgm[i], m);
+  m.ordenada = m.ordenada && sgm.empty();
+  return true;
+}
+
+static bool genRemoverDeCadena(modelo &m) {
+  if (!locValido(m))
+    return false;
+  printf("removerDeCadena");
+  quitarClaves(m.loc, m.loc, m);
+  return true;
+}
+
+static bool genBorrarSegmento(modelo &m) {
+  if (m.claves.empty())
+    return false;
+  nat k1 = entre(1, m.claves.size(), m);
+  nat k2 = std::min<nat>(m.claves.size(), k1 + entre(0, MAX_SEGMENTO - 1, m));
+  printf("borrarSegmento %u %u", k1, k2);
+  quitarClaves(k1 - 1, k2 - 1, m);
+  return true;
+}
+
+static bool genCopiarSegmento(modelo &m) {
+  if (m.claves.empty())
+    return false;
+  nat k1 = entre(1, m.claves.size(), m);
+  nat k2 = std::min<nat>(m.claves.size(), k1 + entre(0, MAX_SEGMENTO - 1, m));
+  printf("copiarSegmento %u %u", k1, k2);
+  return true;
+}
+
+static bool genInicioCadena(modelo &m) {
+  printf("inicioCadena");
+  m.loc = m.claves.empty() ? -1 : 0;
+  return true;
+}
+
+static bool genFinalCadena(modelo &m) {
+  printf("finalCadena");
+  m.loc = (long)m.claves.size() - 1;
+  return true;
+}
+
+static bool genSiguiente(modelo &m) {
+  if (!locValido(m))
+    return false;
+  printf("siguiente");
+  m.loc = (m.loc + 1 < (long)m.claves.size()) ? m.loc + 1 : -1;
+  return true;
+}
+
+static bool genAnterior(modelo &m) {
+  if (!locValido(m))
+    return false;
+  printf("anterior");
+  m.loc--;
+  return true;
+}
+
+static bool genKesimo(modelo &m) {
+  // de vez en cuando una posición fuera de 'cad'
+  nat k = entre(1, m.claves.size() + 1, m);
+  printf("kesimo %u", k);
+  m.loc = (k <= m.claves.size()) ? (long)k - 1 : -1;
+  return true;
+}
+
+static bool genInfoCadena(modelo &m) {
+  if (!locValido(m))
+    return false;
+  printf("infoCadena");
+  return true;
+}
+
+static bool genCambiarEnCadena(modelo &m) {
+  if (!locValido(m))
+    return false;
+  nat c = claveNueva(m);
+  printf("cambiarEnCadena");
+  imprimirInfo(c, m);
+  m.presentes.erase(m.claves[m.loc]);
+  m.presentes.insert(c);
+  m.claves[m.loc] = c;
+  m.ordenada = false;
+  return true;
+}
+
+static bool genIntercambiar(modelo &m) {
+  if (m.claves.empty())
+    return false;
+  nat k1 = entre(1, m.claves.size(), m), k2 = entre(1, m.claves.size(), m);
+  printf("intercambiar %u %u", k1, k2);
+  std::swap(m.claves[k1 - 1], m.claves[k2 - 1]);
+  m.ordenada = m.ordenada && (k1 == k2);
+  return true;
+}
+
+static bool genSiguienteClave(modelo &m) {
+  if (!m.claves.empty() && !locValido(m))
+    return false;
+  nat c = claveBuscada(m);
+  printf("siguienteClave %u", c);
+  if (locValido(m)) {
+    auto it = std::find(m.claves.begin() + m.loc, m.claves.end(), c);
+    m.loc = (it == m.claves.end()) ? -1 : it - m.claves.begin();
+  }
+  return true;
+}
+
+static bool genAnteriorClave(modelo &m) {
+  if (!m.claves.empty() && !locValido(m))
+    return false;
+  nat c = claveBuscada(m);
+  printf("anteriorClave %u", c);
+  if (locValido(m)) {
+    long i = m.loc;
+    while ((i >= 0) && (m.claves[i] != c))
+      i--;
+    m.loc = i;
+  }
+  return true;
+}
+
+static bool genMenorEnCadena(modelo &m) {
+  if (!locValido(m))
+    return false;
+  printf("menorEnCadena");
+  m.loc = std::min_element(m.claves.begin() + m.loc, m.claves.end()) -
+          m.claves.begin();
+  return true;
+}
+
+static bool genPertenece(modelo &m) {
+  printf("pertenece %u", claveBuscada(m));
+  return true;
+}
+
+static bool genCambiarTodos(modelo &m) {
+  nat original = claveBuscada(m);
+  nat nuevo = claveNueva(m);
+  printf("cambiarTodos %u %u", original, nuevo);
+  if (m.presentes.erase(original) > 0) {
+    *std::find(m.claves.begin(), m.claves.end(), original) = nuevo;
+    m.presentes.insert(nuevo);
+    m.ordenada = false;
+  }
+  return true;
+}
+
+static bool genOrdenar(modelo &m) {
+  printf("ordenar");
+  std::sort(m.claves.begin(), m.claves.end());
+  m.ordenada = true;
+  return true;
+}
+
+static bool genSubCadena(modelo &m) {
+  if (!m.ordenada || m.claves.empty())
+    return false;
+  nat i = entre(0, m.claves.size() - 1, m);
+  nat j = std::min<nat>(m.claves.size() - 1, i + entre(0, MAX_SEGMENTO - 1, m));
+  printf("subCadena %u %u", m.claves[i], m.claves[j]);
+  return true;
+}
+
+static bool genSonIgualesCadena(modelo &m) {
+  printf("sonIgualesCadena");
+  imprimirCadenaNueva(entre(0, 3, m), m);
+  return true;
+}
+
+static bool genConcatenar(modelo &m) {
+  if (m.claves.size() > 10 * MAX_SEGMENTO)
+    return false;
+  printf("concatenar");
+  imprimirCadenaNueva(entre(0, 3, m), m);
+  return true;
+}
+
+static bool genImprimirCadena(modelo &m) {
+  if (m.claves.size() > 10 * MAX_SEGMENTO)
+    return false;
+  printf("imprimirCadena");
+  return true;
+}
+
+static bool genPrecedeEnCadena(modelo &m) {
+  printf("precedeEnCadena %u", entre(1, m.claves.size() + 1, m));
+  return true;
+}
+
+static bool genReiniciar(modelo &m) {
+  printf("reiniciar");
+  m.claves.clear();
+  m.presentes.clear();
+  m.loc = -1;
+  m.ordenada = true;
+  return true;
+}
+
+/*
+  Comandos sin parámetros que no cambian el modelo.
+*/
+#define CONSULTA(funcion, nombre)                                              \
+  static bool funcion(modelo &m) {                                             \
+    printf(nombre);                                                            \
+    return true;                                                               \
+  }
+CONSULTA(genEsLocalizador, "esLocalizador")
+CONSULTA(genEsVaciaCadena, "esVaciaCadena")
+CONSULTA(genEsInicioCadena, "esInicioCadena")
+CONSULTA(genEsFinalCadena, "esFinalCadena")
+CONSULTA(genLocalizadorEnCadena, "localizadorEnCadena")
+CONSULTA(genLongitud, "longitud")
+CONSULTA(genEstaOrdenadaPorNaturales, "estaOrdenadaPorNaturales")
+CONSULTA(genHayNatsRepetidos, "hayNatsRepetidos")
+
+struct generadorComando {
+  const char *nombre;
+  bool (*generar)(modelo &m);
+};
+
+static const generadorComando generadores[] = {
+    {"anterior", genAnterior},
+    {"anteriorClave", genAnteriorClave},
+    {"borrarSegmento", genBorrarSegmento},
+    {"cambiarEnCadena", genCambiarEnCadena},
+    {"cambiarTodos", genCambiarTodos},
+    {"concatenar", genConcatenar},
+    {"copiarSegmento", genCopiarSegmento},
+    {"esFinalCadena", genEsFinalCadena},
+    {"esInicioCadena", genEsInicioCadena},
+    {"esLocalizador", genEsLocalizador},
+    {"esVaciaCadena", genEsVaciaCadena},
+    {"estaOrdenadaPorNaturales", genEstaOrdenadaPorNaturales},
+    {"finalCadena", genFinalCadena},
+    {"hayNatsRepetidos", genHayNatsRepetidos},
+    {"imprimirCadena", genImprimirCadena},
+    {"infoCadena", genInfoCadena},
+    {"inicioCadena", genInicioCadena},
+    {"insertarAlFinal", genInsertarAlFinal},
+    {"insertarAntes", genInsertarAntes},
+    {"insertarSegmentoDespues", genInsertarSegmentoDespues},
+    {"intercambiar", genIntercambiar},
+    {"kesimo", genKesimo},
+    {"localizadorEnCadena", genLocalizadorEnCadena},
+    {"longitud", genLongitud},
+    {"menorEnCadena", genMenorEnCadena},
+    {"ordenar", genOrdenar},
+    {"pertenece", genPertenece},
+    {"precedeEnCadena", genPrecedeEnCadena},
+    {"reiniciar", genReiniciar},
+    {"removerDeCadena", genRemoverDeCadena},
+    {"siguiente", genSiguiente},
+    {"siguienteClave", genSiguienteClave},
+    {"sonIgualesCadena", genSonIgualesCadena},
+    {"subCadena", genSubCadena},
+};
+static const nat CANT_GENERADORES =
+    sizeof(generadores) / sizeof(generadorComando);
+
+struct mezcla {
+  const char *nombre;
+  const char *pesos;
+};
+
+static const mezcla mezclas[] = {
+    {"agregado", "insertarAlFinal=80,insertarAntes=5,inicioCadena=3,"
+                 "finalCadena=2,longitud=3,removerDeCadena=4,"
+                 "borrarSegmento=1,esVaciaCadena=2"},
+    {"posicional", "kesimo=40,infoCadena=15,siguiente=10,anterior=10,"
+                   "intercambiar=10,cambiarEnCadena=5,insertarAlFinal=8,"
+                   "removerDeCadena=2"},
+    {"busqueda", "pertenece=30,siguienteClave=20,anteriorClave=15,"
+                 "menorEnCadena=10,inicioCadena=8,finalCadena=4,"
+                 "insertarAlFinal=10,cambiarTodos=3"},
+    {"ordenamiento", "ordenar=5,subCadena=30,estaOrdenadaPorNaturales=10,"
+                     "hayNatsRepetidos=2,insertarAlFinal=35,"
+                     "intercambiar=8,borrarSegmento=5,copiarSegmento=5"},
+    {"mixta",
+     "anterior=3,anteriorClave=3,borrarSegmento=2,cambiarEnCadena=3,"
+     "cambiarTodos=2,concatenar=1,copiarSegmento=2,esFinalCadena=1,"
+     "esInicioCadena=1,esLocalizador=1,esVaciaCadena=1,"
+     "estaOrdenadaPorNaturales=2,finalCadena=3,hayNatsRepetidos=1,"
+     "imprimirCadena=1,infoCadena=5,inicioCadena=4,insertarAlFinal=20,"
+     "insertarAntes=4,insertarSegmentoDespues=2,intercambiar=3,kesimo=8,"
+     "localizadorEnCadena=2,longitud=3,menorEnCadena=2,ordenar=1,"
+     "pertenece=6,precedeEnCadena=2,removerDeCadena=4,siguiente=4,"
+     "siguienteClave=3,sonIgualesCadena=1,subCadena=3"},
+};
+static const nat CANT_MEZCLAS = sizeof(mezclas) / sizeof(mezcla);
+
+static const generadorComando *buscarGenerador(const char *nombre, nat largo) {
+  for (nat i = 0; i < CANT_GENERADORES; i++)
+    if ((strlen(generadores[i].nombre) == largo) &&
+        !strncmp(generadores[i].nombre, nombre, largo))
+      return &generadores[i];
+  return NULL;
+}
+
+/*
+  Interpreta 'pesos' ("nombre=peso,..."). Devuelve 'false' si un nombre no es
+  un comando o un peso no es un número.
+*/
+static bool leerPesos(const char *pesos,
+                      std::vector<const generadorComando *> &comandos,
+                      std::vector<nat> &acumulados) {
+  nat total = 0;
+  const char *p = pesos;
+  while (*p != '\0') {
+    const char *igual = strchr(p, '=');
+    if (igual == NULL)
+      return false;
+    const generadorComando *g = buscarGenerador(p, igual - p);
+    char *fin;
+    unsigned long peso = strtoul(igual + 1, &fin, 10);
+    if ((g == NULL) || (fin == igual + 1) || ((*fin != ',') && (*fin != '\0')))
+      return false;
+    total += peso;
+    comandos.push_back(g);
+    acumulados.push_back(total);
+    p = (*fin == ',') ? fin + 1 : fin;
+  }
+  return total > 0;
+}
+
+static void uso(const char *programa) {
+  fprintf(stderr,
+          "Uso: %s [--mezcla NOMBRE | --pesos LISTA] [--lineas N] "
+          "[--semilla S] [--inicial N] [--maximo N]\n"
+          "Mezclas:",
+          programa);
+  for (nat i = 0; i < CANT_MEZCLAS; i++)
+    fprintf(stderr, " %s", mezclas[i].nombre);
+  fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[]) {
+  const char *pesos = NULL;
+  nat lineas = 100000, semilla = 1, inicial = 1000, maximo = 10000;
+  bool bienFormada = (argc % 2 == 1);
+  for (int i = 1; bienFormada && (i < argc); i += 2) {
+    const char *valor = argv[i + 1];
+    if (!strcmp(argv[i], "--mezcla")) {
+      pesos = NULL;
+      for (nat k = 0; k < CANT_MEZCLAS; k++)
+        if (!strcmp(valor, mezclas[k].nombre))
+          pesos = mezclas[k].pesos;
+      bienFormada = (pesos != NULL);
+    } else if (!strcmp(argv[i], "--pesos")) {
+      pesos = valor;
+    } else if (!strcmp(argv[i], "--lineas")) {
+      lineas = atol(valor);
+    } else if (!strcmp(argv[i], "--semilla")) {
+      semilla = atol(valor);
+    } else if (!strcmp(argv[i], "--inicial")) {
+      inicial = atol(valor);
+    } else if (!strcmp(argv[i], "--maximo")) {
+      maximo = atol(valor);
+    } else {
+      bienFormada = false;
+    }
+  }
+  std::vector<const generadorComando *> comandos;
+  std::vector<nat> acumulados;
+  if (pesos == NULL)
+    pesos = mezclas[CANT_MEZCLAS - 1].pesos;
+  if (bienFormada)
+    bienFormada = leerPesos(pesos, comandos, acumulados);
+  if (!bienFormada || (inicial > maximo)) {
+    uso(argv[0]);
+    return 1;
+  }
+
+  modelo m;
+  m.loc = -1;
+  m.ordenada = true;
+  m.maximo = maximo;
+  m.azar.seed(semilla);
+
+  nat emitidas = 0;
+  while ((emitidas < inicial) && (emitidas < lineas)) {
+    genInsertarAlFinal(m);
+    printf("\n");
+    emitidas++;
+  }
+  while (emitidas < lineas) {
+    // si el comando elegido no se puede emitir se elige otro; 'inicioCadena'
+    // siempre se puede, y suele habilitar a los demás
+    bool emitido = false;
+    for (nat intento = 0; !emitido && (intento < 20); intento++) {
+      nat r = entre(0, acumulados.back() - 1, m);
+      nat k = std::upper_bound(acumulados.begin(), acumulados.end(), r) -
+              acumulados.begin();
+      emitido = comandos[k]->generar(m);
+    }
+    if (!emitido)
+      genInicioCadena(m);
+    printf("\n");
+    emitidas++;
+  }
+  printf("Fin\n");
+  return 0;
+}
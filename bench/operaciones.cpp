@@ -0,0 +1,1115 @@
+/*
+  Medición de las operaciones de 'cadena' y 'usoTads'.
+
+  Cada operación se mide sobre cadenas de 10^3 a 10^7 elementos y se compara,
+  cuando tiene sentido, con la operación análoga de 'std::list',
+  'std::vector' y 'std::deque' de elementos {natural, real}, y con la de
+  'TCadenaT' (ver cadenaT.h) con los elementos guardados en los nodos. También se mide
+  la memoria que ocupa cada estructura por elemento.
+
+  El resultado se imprime en formato JSON en la salida estándar:
+    {
+      "resultados": [
+        {"operacion": ..., "estructura": ..., "n": ..., "ns_por_op": ...,
+         "operaciones": ...},
+        {"operacion": ..., "estructura": ..., "n": ..., "omitido": ...}, ...
+      ],
+      "memoria": [
+        {"estructura": ..., "n": ..., "bytes_por_elemento": ...}, ...
+      ]
+    }
+  Se omiten las mediciones que, según el crecimiento observado en los tamaños
+  anteriores, demorarían más que el límite.
+
+  Uso:
+    operaciones [--min N] [--max N] [--limite SEGUNDOS] [--solo OPERACION]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/cadena.h"
+#include "../include/cadenaT.h"
+#include "../include/info.h"
+#include "../include/usoTads.h"
+#include "../include/utils.h"
+
+#include <fcntl.h>
+#include <limits.h> // UINT_MAX
+#include <malloc.h> // mallinfo2
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <random>
+#include <vector>
+
+// Cantidad de elementos que se procesan, como mínimo, en cada ronda: con
+// cadenas chicas la operación se repite sobre varias copias.
+#define ESCALA 100000
+// Tiempo medido mínimo de cada punto, en segundos.
+#define TIEMPO_MINIMO 0.05
+// Tiempo total (con la preparación) a partir del cual no se hacen más rondas.
+#define TIEMPO_MAXIMO 1.0
+
+struct elemento {
+  nat natural;
+  double real;
+  bool operator==(const elemento &otro) const {
+    return (natural == otro.natural) && (real == otro.real);
+  }
+};
+
+struct medicion {
+  double segundos;
+  double operaciones;
+};
+
+/*
+  Mide 'reps' veces una operación sobre estructuras de 'n' elementos. La
+  preparación y la liberación de las estructuras no se incluyen en el tiempo.
+*/
+typedef medicion (*TMedicion)(nat n, nat reps);
+
+struct caso {
+  const char *operacion;
+  const char *estructura;
+  TMedicion medir;
+};
+
+// Resultados de las operaciones que no se usan, para que no se descarten.
+static volatile unsigned long sumidero = 0;
+
+static double segundos() {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+template <class F> static double cronometrar(F f) {
+  double t0 = segundos();
+  f();
+  return segundos() - t0;
+}
+
+/*
+  Repite 'f', que hace 'reps' operaciones sin modificar la estructura, hasta
+  acumular TIEMPO_MINIMO segundos. Así las operaciones rápidas no dependen de
+  preparar muchas estructuras.
+*/
+template <class F> static medicion repetir(nat reps, F f) {
+  medicion res = {0, 0};
+  while (res.segundos < TIEMPO_MINIMO) {
+    res.segundos += cronometrar(f);
+    res.operaciones += reps;
+  }
+  return res;
+}
+
+/*
+  Claves de los elementos: 0 .. n - 1 en orden o en un orden al azar fijo.
+*/
+static std::vector<nat> claves(nat n, bool mezcladas) {
+  std::vector<nat> res(n);
+  for (nat i = 0; i < n; i++)
+    res[i] = i;
+  if (mezcladas)
+    std::shuffle(res.begin(), res.end(), std::mt19937(n));
+  return res;
+}
+
+// Clave que no está en ninguna estructura.
+static const nat AUSENTE = UINT_MAX;
+
+static TCadena armarCadena(const std::vector<nat> &cs) {
+  TCadena cad = crearCadena();
+  for (nat c : cs)
+    insertarAlFinal(crearInfo(c, c * 0.5), cad);
+  return cad;
+}
+
+static std::vector<TCadena> armarCadenas(nat n, nat reps, bool mezcladas) {
+  std::vector<nat> cs = claves(n, mezcladas);
+  std::vector<TCadena> res;
+  for (nat r = 0; r < reps; r++)
+    res.push_back(armarCadena(cs));
+  return res;
+}
+
+static void liberarCadenas(std::vector<TCadena> &cads) {
+  for (TCadena cad : cads)
+    liberarCadena(cad);
+}
+
+template <class C> static C armar(const std::vector<nat> &cs) {
+  C res;
+  for (nat c : cs)
+    res.push_back(elemento{c, c * 0.5});
+  return res;
+}
+
+template <class C>
+static std::vector<C> armarVarios(nat n, nat reps, bool mezcladas) {
+  std::vector<nat> cs = claves(n, mezcladas);
+  return std::vector<C>(reps, armar<C>(cs));
+}
+
+// --------------------------------------------------------------------
+// Operaciones de 'cadena'.
+
+static medicion cadCrearCadena(nat n, nat reps) {
+  std::vector<TCadena> cads(n * reps);
+  double t = cronometrar([&] {
+    for (TCadena &cad : cads)
+      cad = crearCadena();
+  });
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadLiberarCadena(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  double t = cronometrar([&] { liberarCadenas(cads); });
+  return {t, (double)reps};
+}
+
+/*
+  Mide 'n' * 'reps' invocaciones de una operación de tiempo constante sobre
+  una cadena de 'n' elementos.
+*/
+template <class F> static medicion constante(nat n, nat reps, F op) {
+  std::vector<TCadena> cads = armarCadenas(n, 1, false);
+  TCadena cad = cads[0];
+  unsigned long suma = 0;
+  medicion res = repetir(n * reps, [&] {
+    for (nat i = 0; i < n * reps; i++)
+      suma += op(cad);
+  });
+  sumidero += suma;
+  liberarCadenas(cads);
+  return res;
+}
+
+static medicion cadEsLocalizador(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) {
+    return esLocalizador(inicioCadena(cad));
+  });
+}
+
+static medicion cadEsVaciaCadena(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) { return esVaciaCadena(cad); });
+}
+
+static medicion cadInicioCadena(nat n, nat reps) {
+  return constante(n, reps,
+                   [](TCadena cad) { return inicioCadena(cad) != NULL; });
+}
+
+static medicion cadFinalCadena(nat n, nat reps) {
+  return constante(n, reps,
+                   [](TCadena cad) { return finalCadena(cad) != NULL; });
+}
+
+static medicion cadInfoCadena(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) {
+    return natInfo(infoCadena(inicioCadena(cad), cad));
+  });
+}
+
+static medicion cadEsInicioCadena(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) {
+    return esInicioCadena(finalCadena(cad), cad);
+  });
+}
+
+static medicion cadEsFinalCadena(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) {
+    return esFinalCadena(inicioCadena(cad), cad);
+  });
+}
+
+static medicion cadSiguiente(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  unsigned long suma = 0;
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      for (TLocalizador loc = inicioCadena(cad); esLocalizador(loc);
+           loc = siguiente(loc, cad))
+        suma += natInfo(infoCadena(loc, cad));
+  });
+  sumidero += suma;
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadAnterior(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  unsigned long suma = 0;
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      for (TLocalizador loc = finalCadena(cad); esLocalizador(loc);
+           loc = anterior(loc, cad))
+        suma += natInfo(infoCadena(loc, cad));
+  });
+  sumidero += suma;
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadInsertarAlFinal(nat n, nat reps) {
+  std::vector<TCadena> cads(reps);
+  for (TCadena &cad : cads)
+    cad = crearCadena();
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      for (nat i = 0; i < n; i++)
+        insertarAlFinal(crearInfo(i, i * 0.5), cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadInsertarAntes(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(1, reps, false);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      for (nat i = 1; i < n; i++)
+        insertarAntes(crearInfo(i, i * 0.5), inicioCadena(cad), cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadRemoverDeCadena(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      while (!esVaciaCadena(cad))
+        removerDeCadena(inicioCadena(cad), cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadImprimirCadenaEn(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  int fd = open("/dev/null", O_WRONLY);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      imprimirCadenaEn(fd, cad);
+  });
+  close(fd);
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+/*
+  Mide 'reps' invocaciones de una operación sobre una cadena de 'n' elementos
+  que no la modifica.
+*/
+template <class F>
+static medicion porLlamada(nat n, nat reps, bool mezcladas, F op) {
+  std::vector<TCadena> cads = armarCadenas(n, 1, mezcladas);
+  TCadena cad = cads[0];
+  unsigned long suma = 0;
+  medicion res = repetir(reps, [&] {
+    for (nat r = 0; r < reps; r++)
+      suma += op(cad);
+  });
+  sumidero += suma;
+  liberarCadenas(cads);
+  return res;
+}
+
+static medicion cadKesimo(nat n, nat reps) {
+  return porLlamada(n, reps, false,
+                    [n](TCadena cad) { return kesimo(n, cad) != NULL; });
+}
+
+static medicion cadLocalizadorEnCadena(nat n, nat reps) {
+  return porLlamada(n, reps, false, [](TCadena cad) {
+    return localizadorEnCadena(finalCadena(cad), cad);
+  });
+}
+
+static medicion cadPrecedeEnCadena(nat n, nat reps) {
+  return porLlamada(n, reps, false, [](TCadena cad) {
+    return precedeEnCadena(inicioCadena(cad), finalCadena(cad), cad);
+  });
+}
+
+static medicion cadSiguienteClave(nat n, nat reps) {
+  return porLlamada(n, reps, false, [](TCadena cad) {
+    return siguienteClave(AUSENTE, inicioCadena(cad), cad) != NULL;
+  });
+}
+
+static medicion cadAnteriorClave(nat n, nat reps) {
+  return porLlamada(n, reps, false, [](TCadena cad) {
+    return anteriorClave(AUSENTE, finalCadena(cad), cad) != NULL;
+  });
+}
+
+static medicion cadMenorEnCadena(nat n, nat reps) {
+  return porLlamada(n, reps, true, [](TCadena cad) {
+    return natInfo(infoCadena(menorEnCadena(inicioCadena(cad), cad), cad));
+  });
+}
+
+static medicion cadIntercambiar(nat n, nat reps) {
+  return constante(n, reps, [](TCadena cad) {
+    return intercambiar(inicioCadena(cad), finalCadena(cad), cad) != NULL;
+  });
+}
+
+static medicion cadCambiarEnCadena(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  std::vector<TInfo> viejos;
+  viejos.reserve((size_t)n * reps);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      for (TLocalizador loc = inicioCadena(cad); esLocalizador(loc);
+           loc = siguiente(loc, cad)) {
+        viejos.push_back(infoCadena(loc, cad));
+        cambiarEnCadena(crearInfo(0, 0), loc, cad);
+      }
+  });
+  for (TInfo info : viejos)
+    liberarInfo(info);
+  liberarCadenas(cads);
+  return {t, (double)n * reps};
+}
+
+static medicion cadInsertarSegmentoDespues(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(1, reps, false);
+  std::vector<TCadena> sgms = armarCadenas(n, reps, false);
+  double t = cronometrar([&] {
+    for (nat r = 0; r < reps; r++)
+      insertarSegmentoDespues(sgms[r], finalCadena(cads[r]), cads[r]);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadCopiarSegmento(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, 1, false);
+  std::vector<TCadena> copias(reps);
+  TCadena cad = cads[0];
+  double t = cronometrar([&] {
+    for (TCadena &copia : copias)
+      copia = copiarSegmento(inicioCadena(cad), finalCadena(cad), cad);
+  });
+  liberarCadenas(copias);
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadBorrarSegmento(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      borrarSegmento(inicioCadena(cad), finalCadena(cad), cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+// --------------------------------------------------------------------
+// Operaciones de 'usoTads'.
+
+static medicion cadPertenece(nat n, nat reps) {
+  return porLlamada(n, reps, false,
+                    [](TCadena cad) { return pertenece(AUSENTE, cad); });
+}
+
+static medicion cadLongitud(nat n, nat reps) {
+  return porLlamada(n, reps, false,
+                    [](TCadena cad) { return longitud(cad); });
+}
+
+static medicion cadEstaOrdenadaPorNaturales(nat n, nat reps) {
+  return porLlamada(n, reps, false, [](TCadena cad) {
+    return estaOrdenadaPorNaturales(cad);
+  });
+}
+
+static medicion cadHayNatsRepetidos(nat n, nat reps) {
+  return porLlamada(n, reps, true,
+                    [](TCadena cad) { return hayNatsRepetidos(cad); });
+}
+
+static medicion cadSonIgualesCadena(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, 2, false);
+  unsigned long suma = 0;
+  medicion res = repetir(reps, [&] {
+    for (nat r = 0; r < reps; r++)
+      suma += sonIgualesCadena(cads[0], cads[1]);
+  });
+  sumidero += suma;
+  liberarCadenas(cads);
+  return res;
+}
+
+static medicion cadConcatenar(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n / 2, 2, false);
+  std::vector<TCadena> res(reps);
+  double t = cronometrar([&] {
+    for (TCadena &cad : res)
+      cad = concatenar(cads[0], cads[1]);
+  });
+  liberarCadenas(res);
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadMezclar(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n / 2, reps, false);
+  std::vector<TCadena> otras = armarCadenas(n / 2, reps, false);
+  double t = cronometrar([&] {
+    for (nat r = 0; r < reps; r++)
+      cads[r] = mezclar(cads[r], otras[r]);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadInterseccion(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n / 2, 2, false);
+  std::vector<TCadena> res(reps);
+  double t = cronometrar([&] {
+    for (TCadena &cad : res)
+      cad = interseccionCadenas(cads[0], cads[1]);
+  });
+  liberarCadenas(res);
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadIntersecar(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n / 2, reps, false);
+  std::vector<TCadena> otras = armarCadenas(n / 2, reps, false);
+  double t = cronometrar([&] {
+    for (nat r = 0; r < reps; r++)
+      cads[r] = intersecarCadenas(cads[r], otras[r]);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadOrdenar(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, true);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      ordenar(cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadCambiarTodos(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, reps, false);
+  double t = cronometrar([&] {
+    for (TCadena cad : cads)
+      cambiarTodos(n / 2, AUSENTE, cad);
+  });
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+static medicion cadSubCadena(nat n, nat reps) {
+  std::vector<TCadena> cads = armarCadenas(n, 1, false);
+  std::vector<TCadena> res(reps);
+  double t = cronometrar([&] {
+    for (TCadena &cad : res)
+      cad = subCadena(n / 4, 3 * (n / 4), cads[0]);
+  });
+  liberarCadenas(res);
+  liberarCadenas(cads);
+  return {t, (double)reps};
+}
+
+// --------------------------------------------------------------------
+// Operaciones de 'TCadenaT' con los elementos guardados en los nodos.
+
+typedef TCadenaT<elemento, TPoliticaValor<elemento>> CadenaValor;
+
+static void armarCadenaValor(const std::vector<nat> &cs, CadenaValor &cad) {
+  for (nat c : cs)
+    cad.insertarAlFinal(elemento{c, c * 0.5});
+}
+
+/*
+  Mide 'reps' invocaciones de una operación sobre una 'CadenaValor' de 'n'
+  elementos que no la modifica.
+*/
+template <class F>
+static medicion porLlamadaValor(nat n, nat reps, bool mezcladas, F op) {
+  CadenaValor cad;
+  armarCadenaValor(claves(n, mezcladas), cad);
+  unsigned long suma = 0;
+  medicion res = repetir(reps, [&] {
+    for (nat r = 0; r < reps; r++)
+      suma += op(cad);
+  });
+  sumidero += suma;
+  cad.vaciar();
+  return res;
+}
+
+static medicion valInsertarAlFinal(nat n, nat reps) {
+  std::vector<CadenaValor> cads(reps);
+  double t = cronometrar([&] {
+    for (CadenaValor &cad : cads)
+      for (nat i = 0; i < n; i++)
+        cad.insertarAlFinal(elemento{i, i * 0.5});
+  });
+  for (CadenaValor &cad : cads)
+    cad.vaciar();
+  return {t, (double)n * reps};
+}
+
+static medicion valKesimo(nat n, nat reps) {
+  return porLlamadaValor(n, reps, false, [n](CadenaValor &cad) {
+    nat recorridos = 0;
+    return cad.kesimo(n, recorridos) != NULL;
+  });
+}
+
+static medicion valSiguienteClave(nat n, nat reps) {
+  return porLlamadaValor(n, reps, false, [](CadenaValor &cad) {
+    nat recorridos = 0;
+    return CadenaValor::buscarAdelante(AUSENTE, cad.inicio, recorridos) !=
+           NULL;
+  });
+}
+
+static medicion valAnteriorClave(nat n, nat reps) {
+  return porLlamadaValor(n, reps, false, [](CadenaValor &cad) {
+    nat recorridos = 0;
+    return CadenaValor::buscarAtras(AUSENTE, cad.final, recorridos) != NULL;
+  });
+}
+
+static medicion valMenorEnCadena(nat n, nat reps) {
+  return porLlamadaValor(n, reps, true, [](CadenaValor &cad) {
+    nat recorridos = 0;
+    return CadenaValor::menor(cad.inicio, recorridos)->dato.natural;
+  });
+}
+
+static medicion valOrdenar(nat n, nat reps) {
+  std::vector<nat> cs = claves(n, true);
+  std::vector<CadenaValor> cads(reps);
+  for (CadenaValor &cad : cads)
+    armarCadenaValor(cs, cad);
+  nat recorridos = 0;
+  double t = cronometrar([&] {
+    for (CadenaValor &cad : cads)
+      cad.ordenar(recorridos);
+  });
+  for (CadenaValor &cad : cads)
+    cad.vaciar();
+  return {t, (double)reps};
+}
+
+// --------------------------------------------------------------------
+// Operaciones análogas de los contenedores de la biblioteca estándar.
+
+template <class C> static medicion stlSiguiente(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  unsigned long suma = 0;
+  double t = cronometrar([&] {
+    for (const C &c : cs)
+      for (auto it = c.begin(); it != c.end(); ++it)
+        suma += it->natural;
+  });
+  sumidero += suma;
+  return {t, (double)n * reps};
+}
+
+template <class C> static medicion stlAnterior(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  unsigned long suma = 0;
+  double t = cronometrar([&] {
+    for (const C &c : cs)
+      for (auto it = c.rbegin(); it != c.rend(); ++it)
+        suma += it->natural;
+  });
+  sumidero += suma;
+  return {t, (double)n * reps};
+}
+
+template <class C> static medicion stlInsertarAlFinal(nat n, nat reps) {
+  std::vector<C> cs(reps);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      for (nat i = 0; i < n; i++)
+        c.push_back(elemento{i, i * 0.5});
+  });
+  return {t, (double)n * reps};
+}
+
+template <class C> static medicion stlInsertarAntes(nat n, nat reps) {
+  std::vector<C> cs(reps);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      for (nat i = 0; i < n; i++)
+        c.insert(c.begin(), elemento{i, i * 0.5});
+  });
+  return {t, (double)n * reps};
+}
+
+template <class C> static medicion stlRemoverDeCadena(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      while (!c.empty())
+        c.erase(c.begin());
+  });
+  return {t, (double)n * reps};
+}
+
+template <class C> static medicion stlLiberarCadena(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      C().swap(c);
+  });
+  return {t, (double)reps};
+}
+
+template <class C, class F>
+static medicion stlPorLlamada(nat n, nat reps, bool mezcladas, F op) {
+  C c = armar<C>(claves(n, mezcladas));
+  unsigned long suma = 0;
+  medicion res = repetir(reps, [&] {
+    for (nat r = 0; r < reps; r++)
+      suma += op(c);
+  });
+  sumidero += suma;
+  return res;
+}
+
+template <class C> static medicion stlKesimo(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, false, [n](C &c) {
+    return std::next(c.begin(), n - 1)->natural;
+  });
+}
+
+template <class C> static medicion stlSiguienteClave(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, false, [](C &c) {
+    return std::find_if(c.begin(), c.end(), [](const elemento &e) {
+             return e.natural == AUSENTE;
+           }) != c.end();
+  });
+}
+
+template <class C> static medicion stlAnteriorClave(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, false, [](C &c) {
+    return std::find_if(c.rbegin(), c.rend(), [](const elemento &e) {
+             return e.natural == AUSENTE;
+           }) != c.rend();
+  });
+}
+
+template <class C> static medicion stlMenorEnCadena(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, true, [](C &c) {
+    return std::min_element(c.begin(), c.end(),
+                            [](const elemento &a, const elemento &b) {
+                              return a.natural < b.natural;
+                            })
+        ->natural;
+  });
+}
+
+template <class C> static medicion stlIntercambiar(nat n, nat reps) {
+  C c = armar<C>(claves(n, false));
+  medicion res = repetir(n * reps, [&] {
+    for (nat i = 0; i < n * reps; i++)
+      std::iter_swap(c.begin(), std::prev(c.end()));
+  });
+  sumidero += c.front().natural;
+  return res;
+}
+
+template <class C> static medicion stlCambiarEnCadena(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      for (elemento &e : c)
+        e = elemento{0, 0};
+  });
+  return {t, (double)n * reps};
+}
+
+template <class C>
+static medicion stlInsertarSegmentoDespues(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(1, reps, false);
+  std::vector<C> sgms = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (nat r = 0; r < reps; r++) {
+      if constexpr (std::is_same<C, std::list<elemento>>::value)
+        cs[r].splice(cs[r].end(), sgms[r]);
+      else
+        cs[r].insert(cs[r].end(), sgms[r].begin(), sgms[r].end());
+    }
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlCopiarSegmento(nat n, nat reps) {
+  C c = armar<C>(claves(n, false));
+  std::vector<C> copias(reps);
+  double t = cronometrar([&] {
+    for (C &copia : copias)
+      copia = c;
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlBorrarSegmento(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      c.erase(c.begin(), c.end());
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlPertenece(nat n, nat reps) {
+  return stlSiguienteClave<C>(n, reps);
+}
+
+template <class C> static medicion stlLongitud(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, false, [](C &c) { return c.size(); });
+}
+
+template <class C>
+static medicion stlEstaOrdenadaPorNaturales(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, false, [](C &c) {
+    return std::is_sorted(c.begin(), c.end(),
+                          [](const elemento &a, const elemento &b) {
+                            return a.natural < b.natural;
+                          });
+  });
+}
+
+template <class C> static medicion stlHayNatsRepetidos(nat n, nat reps) {
+  return stlPorLlamada<C>(n, reps, true, [](C &c) {
+    std::vector<nat> nats;
+    nats.reserve(c.size());
+    for (const elemento &e : c)
+      nats.push_back(e.natural);
+    std::sort(nats.begin(), nats.end());
+    return std::adjacent_find(nats.begin(), nats.end()) != nats.end();
+  });
+}
+
+template <class C> static medicion stlSonIgualesCadena(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, 2, false);
+  unsigned long suma = 0;
+  medicion res = repetir(reps, [&] {
+    for (nat r = 0; r < reps; r++)
+      suma += (cs[0] == cs[1]);
+  });
+  sumidero += suma;
+  return res;
+}
+
+template <class C> static medicion stlConcatenar(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n / 2, 2, false);
+  std::vector<C> res(reps);
+  double t = cronometrar([&] {
+    for (C &c : res) {
+      c = cs[0];
+      c.insert(c.end(), cs[1].begin(), cs[1].end());
+    }
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlOrdenar(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, true);
+  auto menor = [](const elemento &a, const elemento &b) {
+    return a.natural < b.natural;
+  };
+  double t = cronometrar([&] {
+    for (C &c : cs) {
+      if constexpr (std::is_same<C, std::list<elemento>>::value)
+        c.sort(menor);
+      else
+        std::sort(c.begin(), c.end(), menor);
+    }
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlCambiarTodos(nat n, nat reps) {
+  std::vector<C> cs = armarVarios<C>(n, reps, false);
+  double t = cronometrar([&] {
+    for (C &c : cs)
+      for (elemento &e : c)
+        if (e.natural == n / 2)
+          e.natural = AUSENTE;
+  });
+  return {t, (double)reps};
+}
+
+template <class C> static medicion stlSubCadena(nat n, nat reps) {
+  C c = armar<C>(claves(n, false));
+  std::vector<C> res(reps);
+  nat menor = n / 4, mayor = 3 * (n / 4);
+  double t = cronometrar([&] {
+    for (C &sub : res) {
+      auto desde = std::find_if(c.begin(), c.end(), [=](const elemento &e) {
+        return e.natural == menor;
+      });
+      auto hasta = std::find_if(desde, c.end(), [=](const elemento &e) {
+        return e.natural > mayor;
+      });
+      sub.assign(desde, hasta);
+    }
+  });
+  return {t, (double)reps};
+}
+
+// --------------------------------------------------------------------
+
+typedef std::list<elemento> Lista;
+typedef std::vector<elemento> Vector;
+typedef std::deque<elemento> Deque;
+
+#define STL(operacion, funcion)                                                \
+  {operacion, "list", funcion<Lista>}, {operacion, "vector", funcion<Vector>}, \
+      {operacion, "deque", funcion<Deque>}
+
+static const caso casos[] = {
+    {"crearCadena", "cadena", cadCrearCadena},
+    {"liberarCadena", "cadena", cadLiberarCadena},
+    STL("liberarCadena", stlLiberarCadena),
+    {"esLocalizador", "cadena", cadEsLocalizador},
+    {"esVaciaCadena", "cadena", cadEsVaciaCadena},
+    {"inicioCadena", "cadena", cadInicioCadena},
+    {"finalCadena", "cadena", cadFinalCadena},
+    {"infoCadena", "cadena", cadInfoCadena},
+    {"esInicioCadena", "cadena", cadEsInicioCadena},
+    {"esFinalCadena", "cadena", cadEsFinalCadena},
+    {"siguiente", "cadena", cadSiguiente},
+    STL("siguiente", stlSiguiente),
+    {"anterior", "cadena", cadAnterior},
+    STL("anterior", stlAnterior),
+    {"insertarAlFinal", "cadena", cadInsertarAlFinal},
+    STL("insertarAlFinal", stlInsertarAlFinal),
+    {"insertarAlFinal", "cadenaT", valInsertarAlFinal},
+    {"insertarAntes", "cadena", cadInsertarAntes},
+    STL("insertarAntes", stlInsertarAntes),
+    {"removerDeCadena", "cadena", cadRemoverDeCadena},
+    STL("removerDeCadena", stlRemoverDeCadena),
+    {"imprimirCadenaEn", "cadena", cadImprimirCadenaEn},
+    {"kesimo", "cadena", cadKesimo},
+    STL("kesimo", stlKesimo),
+    {"kesimo", "cadenaT", valKesimo},
+    {"localizadorEnCadena", "cadena", cadLocalizadorEnCadena},
+    {"precedeEnCadena", "cadena", cadPrecedeEnCadena},
+    {"insertarSegmentoDespues", "cadena", cadInsertarSegmentoDespues},
+    STL("insertarSegmentoDespues", stlInsertarSegmentoDespues),
+    {"copiarSegmento", "cadena", cadCopiarSegmento},
+    STL("copiarSegmento", stlCopiarSegmento),
+    {"borrarSegmento", "cadena", cadBorrarSegmento},
+    STL("borrarSegmento", stlBorrarSegmento),
+    {"cambiarEnCadena", "cadena", cadCambiarEnCadena},
+    STL("cambiarEnCadena", stlCambiarEnCadena),
+    {"intercambiar", "cadena", cadIntercambiar},
+    STL("intercambiar", stlIntercambiar),
+    {"siguienteClave", "cadena", cadSiguienteClave},
+    STL("siguienteClave", stlSiguienteClave),
+    {"siguienteClave", "cadenaT", valSiguienteClave},
+    {"anteriorClave", "cadena", cadAnteriorClave},
+    STL("anteriorClave", stlAnteriorClave),
+    {"anteriorClave", "cadenaT", valAnteriorClave},
+    {"menorEnCadena", "cadena", cadMenorEnCadena},
+    STL("menorEnCadena", stlMenorEnCadena),
+    {"menorEnCadena", "cadenaT", valMenorEnCadena},
+    {"pertenece", "cadena", cadPertenece},
+    STL("pertenece", stlPertenece),
+    {"longitud", "cadena", cadLongitud},
+    STL("longitud", stlLongitud),
+    {"estaOrdenadaPorNaturales", "cadena", cadEstaOrdenadaPorNaturales},
+    STL("estaOrdenadaPorNaturales", stlEstaOrdenadaPorNaturales),
+    {"hayNatsRepetidos", "cadena", cadHayNatsRepetidos},
+    STL("hayNatsRepetidos", stlHayNatsRepetidos),
+    {"sonIgualesCadena", "cadena", cadSonIgualesCadena},
+    STL("sonIgualesCadena", stlSonIgualesCadena),
+    {"concatenar", "cadena", cadConcatenar},
+    STL("concatenar", stlConcatenar),
+    {"mezclar", "cadena", cadMezclar},
+    {"interseccionCadenas", "cadena", cadInterseccion},
+    {"intersecarCadenas", "cadena", cadIntersecar},
+    {"ordenar", "cadena", cadOrdenar},
+    STL("ordenar", stlOrdenar),
+    {"ordenar", "cadenaT", valOrdenar},
+    {"cambiarTodos", "cadena", cadCambiarTodos},
+    STL("cambiarTodos", stlCambiarTodos),
+    {"subCadena", "cadena", cadSubCadena},
+    STL("subCadena", stlSubCadena),
+};
+static const nat CANT_CASOS = sizeof(casos) / sizeof(caso);
+
+// --------------------------------------------------------------------
+// Memoria.
+
+/*
+  Bytes asignados por 'malloc' (incluidos los encabezados de cada bloque).
+*/
+static double bytesEnUso() {
+  struct mallinfo2 info = mallinfo2();
+  return (double)info.uordblks + info.hblkhd;
+}
+
+template <class C> static double bytesPorElementoStl(nat n) {
+  std::vector<nat> cs = claves(n, false);
+  double antes = bytesEnUso();
+  C *c = new C(armar<C>(cs));
+  double res = (bytesEnUso() - antes) / n;
+  delete c;
+  return res;
+}
+
+static double bytesPorElementoCadena(nat n) {
+  std::vector<nat> cs = claves(n, false);
+  double antes = bytesEnUso();
+  TCadena cad = armarCadena(cs);
+  double res = (bytesEnUso() - antes) / n;
+  liberarCadena(cad);
+  return res;
+}
+
+static double bytesPorElementoCadenaValor(nat n) {
+  std::vector<nat> cs = claves(n, false);
+  double antes = bytesEnUso();
+  CadenaValor *cad = new CadenaValor;
+  armarCadenaValor(cs, *cad);
+  double res = (bytesEnUso() - antes) / n;
+  cad->vaciar();
+  delete cad;
+  return res;
+}
+
+// --------------------------------------------------------------------
+
+static nat repeticiones(nat n) { return (n < ESCALA) ? ESCALA / n : 1; }
+
+/*
+  Mide 'c' con 'n' elementos, repitiendo rondas hasta acumular
+  TIEMPO_MINIMO segundos medidos o TIEMPO_MAXIMO segundos en total.
+*/
+static medicion medirPunto(const caso &c, nat n) {
+  medicion total = {0, 0};
+  nat rondas = 0;
+  double inicio = segundos();
+  while ((total.segundos < TIEMPO_MINIMO) &&
+         ((rondas == 0) || (segundos() - inicio < TIEMPO_MAXIMO))) {
+    medicion m = c.medir(n, repeticiones(n));
+    total.segundos += m.segundos;
+    total.operaciones += m.operaciones;
+    rondas++;
+  }
+  return total;
+}
+
+/*
+  Lo que se sabe de un caso para estimar cuánto demora con el tamaño
+  siguiente.
+*/
+struct historia {
+  double duracion;    // segundos con el último tamaño, con la preparación
+  double crecimiento; // cociente de 'duracion' entre los dos últimos tamaños
+  bool omitido;
+};
+
+static void imprimirSeparador(bool &primero) {
+  printf(primero ? "\n" : ",\n");
+  primero = false;
+}
+
+int main(int argc, char *argv[]) {
+  nat minimo = 1000, maximo = 10000000;
+  double limite = 20;
+  const char *solo = NULL;
+  bool bienFormada = (argc % 2 == 1);
+  for (int i = 1; bienFormada && (i < argc); i += 2) {
+    if (!strcmp(argv[i], "--min"))
+      minimo = atol(argv[i + 1]);
+    else if (!strcmp(argv[i], "--max"))
+      maximo = atol(argv[i + 1]);
+    else if (!strcmp(argv[i], "--limite"))
+      limite = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "--solo"))
+      solo = argv[i + 1];
+    else
+      bienFormada = false;
+  }
+  if (!bienFormada || (minimo < 2) || (minimo > maximo)) {
+    fprintf(stderr,
+            "Uso: %s [--min N] [--max N] [--limite SEGUNDOS] "
+            "[--solo OPERACION]\n",
+            argv[0]);
+    return 1;
+  }
+
+  std::vector<historia> historias(CANT_CASOS, historia{0, 10, false});
+  printf("{\n  \"resultados\": [");
+  bool primero = true;
+  for (nat n = minimo; n <= maximo; n *= 10) {
+    for (nat k = 0; k < CANT_CASOS; k++) {
+      const caso &c = casos[k];
+      historia &h = historias[k];
+      if ((solo != NULL) && strcmp(solo, c.operacion))
+        continue;
+      imprimirSeparador(primero);
+      double estimado = h.duracion * h.crecimiento;
+      if (h.omitido || (estimado > limite)) {
+        h.omitido = true;
+        printf("    {\"operacion\": \"%s\", \"estructura\": \"%s\", "
+               "\"n\": %u, \"omitido\": \"tiempo estimado %.1f s\"}",
+               c.operacion, c.estructura, n, estimado);
+        continue;
+      }
+      fprintf(stderr, "%s/%s n=%u\n", c.operacion, c.estructura, n);
+      double inicio = segundos();
+      medicion m = medirPunto(c, n);
+      double duracion = segundos() - inicio;
+      if (h.duracion > 0)
+        h.crecimiento = std::max(1.0, duracion / h.duracion);
+      h.duracion = duracion;
+      printf("    {\"operacion\": \"%s\", \"estructura\": \"%s\", \"n\": %u, "
+             "\"ns_por_op\": %.3f, \"operaciones\": %.0f}",
+             c.operacion, c.estructura, n, m.segundos * 1e9 / m.operaciones,
+             m.operaciones);
+    }
+  }
+  printf("\n  ],\n  \"memoria\": [");
+  primero = true;
+  for (nat n = minimo; n <= maximo; n *= 10) {
+    const char *estructuras[] = {"cadena", "cadenaT", "list", "vector",
+                                 "deque"};
+    double bytes[] = {bytesPorElementoCadena(n), bytesPorElementoCadenaValor(n),
+                      bytesPorElementoStl<Lista>(n),
+                      bytesPorElementoStl<Vector>(n),
+                      bytesPorElementoStl<Deque>(n)};
+    for (nat i = 0; i < 5; i++) {
+      imprimirSeparador(primero);
+      printf("    {\"estructura\": \"%s\", \"n\": %u, "
+             "\"bytes_por_elemento\": %.2f}",
+             estructuras[i], n, bytes[i]);
+    }
+  }
+  printf("\n  ]\n}\n");
+  fprintf(stderr, "control %lu\n", (unsigned long)sumidero);
+  return 0;
+}
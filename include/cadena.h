@@ -4,6 +4,38 @@
   Los elementos de tipo 'TCadena' son lista doblemente enlazada de elementos
   de tipo 'Tinfo', con cabezal con punteros al inicio y al final.
 
+  Las operaciones que pasan elementos de una cadena a otra pasan los nodos
+  con sus enlaces, sin copiarlos, por lo que los localizadores siguen
+  accediendo a los mismos elementos.
+
+  Una cadena ordenada por los componentes naturales se puede poner en modo
+  ordenado con 'indexarCadena': se le agrega un índice (una lista de saltos
+  sobre sus nodos) con el que 'insertarOrdenado', 'buscarClave',
+  'cotaInferior' y 'cotaSuperior' son O(log n) en promedio. El índice
+  también resume los componentes reales de cada tramo, con lo que
+  'contarEnRango', 'sumaReales', 'minReal' y 'maxReal' son O(log n) en
+  promedio sobre un rango de naturales. Las operaciones que modifican la
+  cadena mantienen el índice; si dejan la cadena desordenada, o si se le
+  inserta un segmento, la cadena sale del modo ordenado.
+
+  'invertirCadena' invierte una cadena en O(1) cambiando el sentido en que se
+  recorren sus enlaces. Las operaciones que necesitan recorrer los enlaces en
+  orden (las de modo ordenado, 'ordenarCadena', 'menorEnCadena', 'mezclar',
+  las de conjuntos, 'eliminarRepetidos' y las de partición) primero la
+  normalizan con 'normalizar', en O(n).
+
+  Los nodos y elementos que se quitan de una cadena se retiran con el módulo
+  'epocas' y se liberan recién cuando terminan los recorridos que podían
+  estar en ellos. Mientras un hilo modifica una cadena con 'insertarAlFinal',
+  'insertarAntes', 'removerDeCadena' o 'borrarSegmento', otros hilos la
+  pueden recorrer con 'pertenece', 'longitud', 'imprimirCadena',
+  'imprimirCadenaEn' e 'imprimirCadenaEnBuffer', o avanzando con
+  'inicioCadena', 'siguienteSinVerificar' e 'infoCadena' entre
+  'entrarLectura' y 'salirLectura' (ver epocas.h). Cada enlace se ve antes o
+  después de cambiar. Las modificaciones se deben serializar, y el resto de
+  las operaciones, también las de consulta que normalizan la cadena (ver
+  'normalizar'), no se pueden ejecutar a la vez que una modificación.
+
   Laboratorio de Programación 2.
   InCo-FIng-UDELAR
 */
@@ -12,6 +44,7 @@
 #define _CADENA_H
 
 #include "info.h"
+#include "salida.h"
 
 /*
   Las variables de tipo 'TLocalizador' permiten acceder a los elementos en las
@@ -86,6 +119,17 @@ TInfo infoCadena(TLocalizador loc, TCadena cad);
 */
 TLocalizador siguiente(TLocalizador loc, TCadena cad);
 
+/*
+  Como 'siguiente', pero sin verificar la precondición: es O(1) también
+  cuando se compila con 'assert', mientras que 'siguiente' verifica con
+  'localizadorEnCadena', que es O(n). Se usa para recorrer una cadena entera.
+  'loc' puede ser también un nodo que otro hilo quitó de 'cad' durante el
+  recorrido (ver el comienzo de este archivo).
+  Precondición: localizadorEnCadena(loc, cad).
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+TLocalizador siguienteSinVerificar(TLocalizador loc, TCadena cad);
+
 /*
   Devuelve el 'TLocalizador' con el que se accede al elemento de 'cad'
   inmediatamente anterior a 'loc'.
@@ -109,13 +153,19 @@ bool esFinalCadena(TLocalizador loc, TCadena cad);
 */
 bool esInicioCadena(TLocalizador loc, TCadena cad);
 
+// El parámetro 'lugar' de las funciones que insertan es el lugar de la
+// llamada, al que el control de 'memoria' atribuye el nodo creado; no se pasa
+// explícitamente. Las demás operaciones que crean nodos (por ejemplo
+// 'copiarSegmento') se los atribuyen a sí mismas.
+
 /*
   Se inserta 'i' como último elemento de 'cad'.
   Devuelve 'cad'.
   Si esVaciaVadena (cad) 'i' se inserta como único elemento de 'cad'.
   El tiempo de ejecución en el peor caso es O(1).
 */
-TCadena insertarAlFinal(TInfo i, TCadena cad);
+TCadena insertarAlFinal(TInfo i, TCadena cad,
+                        TLugar lugar = TLugar::actual());
 
 /*
   Se inserta 'i' como un nuevo elemento inmediatamente antes de 'loc'.
@@ -123,7 +173,8 @@ TCadena insertarAlFinal(TInfo i, TCadena cad);
   Precondición: localizadorEnCadena(loc, cad).
   El tiempo de ejecución en el peor caso es O(1).
 */
-TCadena insertarAntes(TInfo i, TLocalizador loc, TCadena cad);
+TCadena insertarAntes(TInfo i, TLocalizador loc, TCadena cad,
+                      TLugar lugar = TLugar::actual());
 
 /*
   Se remueve el elemento al que se accede desde 'loc' y se libera la memoria
@@ -146,6 +197,25 @@ TCadena removerDeCadena(TLocalizador loc, TCadena cad);
 */
 void imprimirCadena(TCadena cad);
 
+/*
+  Imprime los elementos de 'cad' en el descriptor 'fd', con el mismo formato
+  que 'imprimirCadena'.
+  La salida se arma en un buffer propio de cada hilo y se escribe en bloques
+  grandes. Si 'fd' es el de la salida estándar se escribe a través de 'stdout'
+  para respetar el orden con lo impreso con 'printf'.
+  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+void imprimirCadenaEn(int fd, TCadena cad);
+
+/*
+  Agrega al final de 'buf' los elementos de 'cad', con el mismo formato que
+  'imprimirCadena'.
+  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+void imprimirCadenaEnBuffer(TBufferSalida buf, TCadena cad);
+
 /*
   Devuelve el 'TLocalizador' con el que se accede al k-esimo elemento de 'cad'.
   Si 'k' es 0 o mayor a la cantidad de elementos de 'cad' devuelve un
@@ -181,7 +251,9 @@ bool precedeEnCadena(TLocalizador loc1, TLocalizador loc2, TCadena cad);
   El valor de 'sgm' queda indeterminado.
   Si esVaciaCadena(cad) 'loc' es ignorado y el segmento queda insertado.
   Precondición: esVaciaCadena(cad) o localizadorEnCadena(loc, cad).
-  El tiempo de ejecución en el peor caso es O(1).
+  El tiempo de ejecución en el peor caso es O(1) si 'sgm' y 'cad' no están
+  una invertida y la otra no (ver 'invertirCadena'), y si no O(k), siendo 'k'
+  la cantidad de elementos de 'sgm'.
 */
 TCadena insertarSegmentoDespues(TCadena sgm, TLocalizador loc, TCadena cad);
 
@@ -260,7 +332,328 @@ TLocalizador anteriorClave(nat clave, TLocalizador loc, TCadena cad);
 */
 TLocalizador menorEnCadena(TLocalizador loc, TCadena cad);
 
+/*
+  Ordena los elementos de 'cad' de manera creciente según sus componentes
+  naturales, moviendo los elementos entre los nodos. El orden entre elementos
+  con igual componente natural se mantiene.
+  Devuelve 'cad'.
+  Se mantienen las relaciones de precedencia entre localizadores.
+  Con hasta 16 elementos se usa una red de ordenamiento.
+  El tiempo de ejecución en el peor caso es O(n^2), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena ordenarCadena(TCadena cad);
+
+/*
+  Pone a 'cad' en modo ordenado: arma un índice sobre sus nodos que se
+  mantiene en cada modificación mientras los elementos sigan ordenados.
+  Devuelve 'cad'.
+  Precondición: los elementos de 'cad' están ordenados de manera no
+  decreciente según sus componentes naturales.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena indexarCadena(TCadena cad);
+
+/*
+  Devuelve 'true' si y solo si 'cad' está en modo ordenado.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+bool estaIndexada(TCadena cad);
+
+/*
+  Se inserta 'i' en 'cad' después de los elementos cuyo componente natural es
+  menor o igual al de 'i' y antes de los demás.
+  Devuelve 'cad'.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena insertarOrdenado(TInfo i, TCadena cad,
+                         TLugar lugar = TLugar::actual());
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es igual a 'clave'. Si no hay devuelve un
+  'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador buscarClave(nat clave, TCadena cad);
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es mayor o igual a 'clave'. Si no hay
+  devuelve un 'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador cotaInferior(nat clave, TCadena cad);
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es mayor a 'clave'. Si no hay devuelve un
+  'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador cotaSuperior(nat clave, TCadena cad);
+
+/*
+  Devuelve el primer 'TLocalizador' de 'cad', desde 'loc' (inclusive), con el
+  que se accede a un elemento cuyo componente natural es mayor o igual a
+  'clave', o uno no válido si no hay. Avanza hasta 8 elementos y, si no
+  alcanza, usa el índice si estaIndexada(cad) y si no sigue avanzando.
+  Sirve para recorrer una cadena ordenada salteando tramos, como en las
+  operaciones de conjuntos.
+  Precondición: estaOrdenadaPorNaturales(cad) y 'loc' no es válido o
+  localizadorEnCadena(loc, cad).
+  El tiempo de ejecución es O(min(d, log n)) en promedio si estaIndexada(cad),
+  y si no O(d) en el peor caso, siendo 'd' la cantidad de elementos salteados
+  y 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador galoparClave(nat clave, TLocalizador loc, TCadena cad);
+
+/*
+  Devuelve la cantidad de elementos de 'cad' cuyo componente natural está
+  entre 'menor' y 'mayor', incluidos.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+nat contarEnRango(nat menor, nat mayor, TCadena cad);
+
+/*
+  Devuelve la suma de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double sumaReales(nat menor, nat mayor, TCadena cad);
+
+/*
+  Devuelve el menor de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  Precondición: contarEnRango(menor, mayor, cad) > 0.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double minReal(nat menor, nat mayor, TCadena cad);
+
+/*
+  Devuelve el mayor de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  Precondición: contarEnRango(menor, mayor, cad) > 0.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double maxReal(nat menor, nat mayor, TCadena cad);
+
+/*
+  Intercala los elementos de 'c2' en 'c1' de manera que 'c1' quede ordenada
+  de manera no decreciente según los componentes naturales. Los elementos de
+  'c2' quedan después de los de 'c1' con el mismo componente natural.
+  Devuelve 'c1'.
+  No se debe obtener memoria (los nodos de 'c2' pasan a ser parte de 'c1').
+  Se libera la memoria asignada al resto de las estructuras de 'c2'.
+  El valor de 'c2' queda indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado, y cada tramo de 'c2' que
+  no va entre los 8 nodos siguientes de 'c1' se ubica con el índice.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log (n1 + n2)) en promedio.
+*/
+TCadena mezclar(TCadena c1, TCadena c2);
+
+/*
+  Deja en 'c1' la unión de 'c1' y 'c2' según los componentes naturales: sus
+  elementos y los de 'c2' cuyo componente natural no es el de ningún
+  elemento de 'c1', intercalados como en 'mezclar'.
+  Devuelve 'c1'.
+  Los nodos de 'c2' que quedan pasan a ser parte de 'c1'; los demás se
+  liberan con sus elementos, como el resto de las estructuras de 'c2'.
+  El valor de 'c2' queda indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log (n1 + n2)) en promedio.
+*/
+TCadena unirCadenas(TCadena c1, TCadena c2);
+
+/*
+  Deja en 'c1' los elementos cuyo componente natural es el de algún elemento
+  de 'c2', en el mismo orden, y libera los demás con sus nodos.
+  Devuelve 'c1'.
+  Se libera la memoria asignada a 'c2'. El valor de 'c2' queda
+  indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c2) es
+  O(n1 log n2) en promedio.
+*/
+TCadena intersecarCadenas(TCadena c1, TCadena c2);
+
+/*
+  Quita de 'c1' los elementos cuyo componente natural es el de algún
+  elemento de 'c2' y los libera con sus nodos.
+  Devuelve 'c1'.
+  Se libera la memoria asignada a 'c2'. El valor de 'c2' queda
+  indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log n1 + k) en promedio, siendo 'k' la cantidad de elementos
+  quitados.
+*/
+TCadena restarCadenas(TCadena c1, TCadena c2);
+
+// Ocurrencia de cada componente natural que conserva 'eliminarRepetidos'.
+enum TPoliticaRepetidos { primeraOcurrencia, ultimaOcurrencia };
+
+/*
+  Quita de 'cad' los elementos cuyo componente natural es el de otro
+  elemento de 'cad', de manera que de cada componente natural quede solo la
+  primera ocurrencia (si 'politica' es 'primeraOcurrencia') o la última (si
+  es 'ultimaOcurrencia'). Los elementos que quedan mantienen su orden.
+  Devuelve 'cad'.
+  Se libera la memoria de los elementos quitados y de sus nodos.
+  Después de la operación no hayNatsRepetidos(cad).
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena eliminarRepetidos(TCadena cad, TPoliticaRepetidos politica);
 
+/*
+  Condición sobre los elementos de una cadena. Recibe el elemento y el
+  contexto que se pasó a la operación que la invoca.
+*/
+typedef bool (*TPredicado)(TInfo info, void *contexto);
 
+/*
+  Quita de 'cad' los elementos para los que 'pred' devuelve 'false' con
+  'contexto' y libera la memoria de esos elementos y de sus nodos. Los
+  elementos que quedan mantienen su orden.
+  Devuelve 'cad'.
+  No se obtiene memoria.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad', más el de las invocaciones a 'pred'.
+*/
+TCadena filtrarCadena(TCadena cad, TPredicado pred, void *contexto);
+
+/*
+  Deja en 'cad' los elementos para los que 'pred' devuelve 'true' con
+  'contexto' y devuelve una 'TCadena' con los demás. Las dos cadenas
+  mantienen el orden relativo de sus elementos.
+  No se obtiene memoria para los nodos (los que pasan al resultado son los de
+  'cad').
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado. El resultado no está en
+  modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad', más el de las invocaciones a 'pred'.
+*/
+TCadena particionarCadena(TCadena cad, TPredicado pred, void *contexto);
+
+/*
+  Quita de 'cad' los elementos cuyo componente natural no está entre 'menor'
+  y 'mayor', incluidos, y libera la memoria de esos elementos y de sus nodos.
+  Es 'filtrarCadena' con ese predicado, pero si 'cad' está en modo ordenado
+  los elementos quitados forman un prefijo y un sufijo que se ubican con el
+  índice.
+  Devuelve 'cad'.
+  No se obtiene memoria.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(log n + k) en promedio si estaIndexada(cad),
+  siendo 'k' la cantidad de elementos quitados, y si no O(n) en el peor caso,
+  siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena filtrarRango(nat menor, nat mayor, TCadena cad);
+
+/*
+  Deja en 'cad' los elementos cuyo componente natural está entre 'menor' y
+  'mayor', incluidos, y devuelve una 'TCadena' con los demás, como
+  'particionarCadena' con ese predicado. Si 'cad' está en modo ordenado los
+  elementos que pasan al resultado forman un prefijo y un sufijo que se
+  ubican con el índice.
+  No se obtiene memoria para los nodos.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado. El resultado no está en
+  modo ordenado.
+  El tiempo de ejecución es O(log n + k) en promedio si estaIndexada(cad),
+  siendo 'k' la cantidad de elementos del resultado, y si no O(n) en el peor
+  caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena particionarRango(nat menor, nat mayor, TCadena cad);
+
+/*
+  Invierte el orden de los elementos de 'cad': el primero pasa a ser el
+  último y cada elemento pasa a seguir al que lo seguía. No se modifican los
+  enlaces sino el sentido en que se recorren, y los localizadores siguen
+  accediendo a los mismos elementos.
+  Devuelve 'cad'.
+  Si estaIndexada(cad) 'cad' sale del modo ordenado.
+  El tiempo de ejecución en el peor caso es O(1) si no estaIndexada(cad), y
+  si no O(n) en promedio, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena invertirCadena(TCadena cad);
+
+/*
+  Si 'cad' está invertida invierte sus enlaces, de manera que el orden de los
+  enlaces vuelva a ser el de los elementos. Los elementos, su orden y los
+  localizadores no cambian. Se usa antes de las operaciones que recorren los
+  enlaces en orden.
+  Devuelve 'cad'.
+  El tiempo de ejecución en el peor caso es O(1) si 'cad' no está invertida,
+  y si no O(n), siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena normalizar(TCadena cad);
+
+/*
+  Pasa a una 'TCadena' nueva, que devuelve, los elementos de 'cad' que siguen
+  a 'loc', manteniendo su orden. 'loc' pasa a ser el final de 'cad'. Es la
+  operación inversa de 'insertarSegmentoDespues'.
+  No se obtiene memoria para los nodos (los que pasan al resultado son los de
+  'cad', y los localizadores siguen accediendo a los mismos elementos).
+  Si estaIndexada(cad) las dos cadenas quedan en modo ordenado.
+  Precondición: localizadorEnCadena(loc, cad).
+  El tiempo de ejecución es O(1) en el peor caso si no estaIndexada(cad) y
+  O(log n) en promedio si estaIndexada(cad), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena partirCadena(TLocalizador loc, TCadena cad);
+
+/*
+  Quita de 'origen' los elementos que se encuentran entre 'desde' y 'hasta',
+  incluidos, y los inserta en 'destino', que puede ser 'origen', manteniendo
+  su orden, inmediatamente después de 'destinoLoc', o al inicio si
+  'destinoLoc' no es válido. Los nodos pasan con sus enlaces, por lo que los
+  localizadores siguen accediendo a los mismos elementos.
+  Devuelve 'destino'.
+  No se obtiene memoria.
+  Si esVaciaCadena(destino) 'destinoLoc' es ignorado.
+  'destino' sale del modo ordenado. Si estaIndexada(origen) y 'destino' no es
+  'origen', 'origen' sigue en modo ordenado.
+  Precondición: precedeEnCadena(desde, hasta, origen), y 'destinoLoc' no es
+  válido, o localizadorEnCadena(destinoLoc, destino) y 'destinoLoc' no está
+  entre 'desde' y 'hasta'.
+  El tiempo de ejecución en el peor caso es O(1) si ninguna de las dos está
+  en modo ordenado y no están una invertida y la otra no (ver
+  'invertirCadena'). Si estaIndexada(origen) se suma O(log n + k) en
+  promedio, si estaIndexada(destino) O(m), y si una está invertida y la otra
+  no O(k), siendo 'n' y 'm' la cantidad de elementos en 'origen' y en
+  'destino' y 'k' la del segmento.
+*/
+TCadena moverSegmento(TLocalizador desde, TLocalizador hasta, TCadena origen,
+                      TLocalizador destinoLoc, TCadena destino);
 
 #endif
@@ -0,0 +1,583 @@
+/*
+  Plantilla de cadenas doblemente enlazadas.
+
+  'TCadenaT<T, Politica>' es una lista doblemente enlazada, con cabezal con
+  punteros al inicio y al final, cuyos nodos guardan el elemento de tipo 'T'
+  en el propio nodo. 'TCadena' (ver cadena.h) es una instancia con 'TInfo'
+  como elemento.
+
+  La política fija en tiempo de compilación:
+  - 'Politica::Nodo', el tipo de los nodos, que debe derivar de
+    'TEnlacesT<T, Politica::Nodo>';
+  - el asignador de nodos, 'Politica::crearNodo(...)' y
+    'Politica::liberarNodo(nodo)';
+  - la indexación: si 'Politica::CONTAR' es 'true' el cabezal mantiene la
+    cantidad de elementos y 'kesimo' avanza desde el extremo más cercano;
+  - el extractor de claves predeterminado, 'Politica::Clave', con una función
+    'static nat clave(const T &)'.
+
+  Las operaciones que comparan por clave reciben el extractor como parámetro
+  de la plantilla, por lo que la comparación se expande en el recorrido sin
+  llamadas a través de punteros a funciones.
+
+  Las operaciones que recorren nodos suman en 'recorridos' la cantidad de
+  nodos que avanzaron, para que quien las usa pueda contarlos (ver
+  estadisticas.h).
+
+  Es responsabilidad de quien instancia la plantilla decidir cuándo se
+  liberan los nodos desenlazados: las operaciones 'desenlazar...' no los
+  liberan y no cambian sus enlaces.
+
+  Los enlaces (y 'inicio' y 'final') son 'TEnlaceT': se escriben con orden
+  'release' y se leen con orden 'acquire', por lo que un hilo puede recorrer
+  los enlaces mientras otro enlaza o desenlaza nodos. Quien llega a un nodo
+  por un enlace ve el nodo ya inicializado.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _CADENAT_H
+#define _CADENAT_H
+
+#include "utils.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+// Puntero a un nodo que se escribe con orden 'release' y se lee con orden
+// 'acquire'. Se usa como un 'N *'.
+template <class N> class TEnlaceT {
+  std::atomic<N *> p;
+
+public:
+  TEnlaceT(N *q = NULL) : p(q) {}
+  TEnlaceT(const TEnlaceT &otro) : p((N *)otro) {}
+  operator N *() const { return p.load(std::memory_order_acquire); }
+  N *operator->() const { return p.load(std::memory_order_acquire); }
+  TEnlaceT &operator=(N *q) {
+    p.store(q, std::memory_order_release);
+    return *this;
+  }
+  TEnlaceT &operator=(const TEnlaceT &otro) { return *this = (N *)otro; }
+};
+
+// Enlaces y elemento de un nodo. 'N' es el tipo del nodo que deriva de este.
+template <class T, class N> struct TEnlacesT {
+  T dato;
+  TEnlaceT<N> anterior;
+  TEnlaceT<N> siguiente;
+};
+
+// Nodo sin más campos que los enlaces y el elemento.
+template <class T> struct TNodoT : TEnlacesT<T, TNodoT<T>> {};
+
+// Asignador de nodos con 'new' y 'delete'.
+template <class N> struct TAsignadorNew {
+  static N *crearNodo() { return new N; }
+  static void liberarNodo(N *nodo) { delete nodo; }
+};
+
+// Extractor de claves para elementos con un campo 'natural'.
+struct TClaveNatural {
+  template <class T> static nat clave(const T &elem) { return elem.natural; }
+};
+
+// Política con nodos 'TNodoT<T>' obtenidos con 'new', con cantidad de
+// elementos y con 'TClaveNatural' como extractor.
+template <class T> struct TPoliticaValor : TAsignadorNew<TNodoT<T>> {
+  typedef TNodoT<T> Nodo;
+  typedef TClaveNatural Clave;
+  static const bool CONTAR = true;
+};
+
+// Cantidad de elementos, que solo se guarda si 'CONTAR'.
+template <bool CONTAR> struct TCantidadT {
+  nat cantidad = 0;
+  void sumar(nat k) { cantidad += k; }
+  void restar(nat k) { cantidad -= k; }
+};
+
+template <> struct TCantidadT<false> {
+  void sumar(nat) {}
+  void restar(nat) {}
+};
+
+/*
+  Pares de posiciones que se comparan, en orden, en la red de ordenamiento de
+  Batcher para 16 elementos. Los pares cuyas posiciones son menores a 'k'
+  forman una red para 'k' elementos.
+*/
+static const unsigned char RED_ORDENAMIENTO[][2] = {
+    {0, 1},   {2, 3},   {4, 5},   {6, 7},   {8, 9},   {10, 11}, {12, 13},
+    {14, 15}, {0, 2},   {1, 3},   {4, 6},   {5, 7},   {8, 10},  {9, 11},
+    {12, 14}, {13, 15}, {1, 2},   {5, 6},   {9, 10},  {13, 14}, {0, 4},
+    {1, 5},   {2, 6},   {3, 7},   {8, 12},  {9, 13},  {10, 14}, {11, 15},
+    {2, 4},   {3, 5},   {10, 12}, {11, 13}, {1, 2},   {3, 4},   {5, 6},
+    {9, 10},  {11, 12}, {13, 14}, {0, 8},   {1, 9},   {2, 10},  {3, 11},
+    {4, 12},  {5, 13},  {6, 14},  {7, 15},  {4, 8},   {5, 9},   {6, 10},
+    {7, 11},  {2, 4},   {3, 5},   {6, 8},   {7, 9},   {10, 12}, {11, 13},
+    {1, 2},   {3, 4},   {5, 6},   {7, 8},   {9, 10},  {11, 12}, {13, 14}};
+static const nat TAM_RED = 16;
+
+template <class T, class Politica>
+struct TCadenaT : TCantidadT<Politica::CONTAR> {
+  typedef typename Politica::Nodo Nodo;
+
+  TEnlaceT<Nodo> inicio;
+  TEnlaceT<Nodo> final;
+
+  bool esVacia() const {
+    assert((inicio == NULL) == (final == NULL));
+    return inicio == NULL;
+  }
+
+  // ------------------------------------------------------------------
+  // Enlaces.
+
+  /*
+    Enlaza 'nuevo' como último nodo.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  void enlazarAlFinal(Nodo *nuevo) {
+    nuevo->siguiente = NULL;
+    nuevo->anterior = final;
+    if (final == NULL)
+      inicio = nuevo;
+    else
+      final->siguiente = nuevo;
+    final = nuevo;
+    this->sumar(1);
+  }
+
+  /*
+    Enlaza 'nuevo' inmediatamente antes de 'loc'.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  void enlazarAntes(Nodo *nuevo, Nodo *loc) {
+    nuevo->siguiente = loc;
+    nuevo->anterior = loc->anterior;
+    if (loc->anterior == NULL)
+      inicio = nuevo;
+    else
+      loc->anterior->siguiente = nuevo;
+    loc->anterior = nuevo;
+    this->sumar(1);
+  }
+
+  /*
+    Desenlaza 'loc'. 'loc' conserva sus enlaces.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  void desenlazar(Nodo *loc) { desenlazarSegmento(loc, loc); }
+
+  /*
+    Desenlaza los nodos que van desde 'desde' hasta 'hasta', incluidos.
+    Los nodos del segmento conservan sus enlaces, también los de los
+    extremos.
+    El tiempo de ejecución en el peor caso es O(1), u O(k) si se lleva la
+    cantidad de elementos, siendo 'k' la cantidad de nodos del segmento.
+  */
+  void desenlazarSegmento(Nodo *desde, Nodo *hasta) {
+    Nodo *antes = desde->anterior;
+    Nodo *despues = hasta->siguiente;
+    if (antes == NULL)
+      inicio = despues;
+    else
+      antes->siguiente = despues;
+    if (despues == NULL)
+      final = antes;
+    else
+      despues->anterior = antes;
+    if constexpr (Politica::CONTAR)
+      this->restar(largoSegmento(desde, hasta));
+  }
+
+  /*
+    Enlaza los nodos de 'sgm' inmediatamente después de 'loc' y deja vacía a
+    'sgm'. Si 'loc' es NULL se enlazan al principio.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  void enlazarSegmentoDespues(TCadenaT &sgm, Nodo *loc) {
+    if (!sgm.esVacia()) {
+      enlazarNodosDespues(sgm.inicio, sgm.final, loc);
+      this->sumar(sgm.cantidadActual());
+      sgm.restar(sgm.cantidadActual());
+      sgm.inicio = sgm.final = NULL;
+    }
+  }
+
+  /*
+    Desenlaza los nodos que van desde 'desde' hasta 'hasta', incluidos, y los
+    enlaza en 'destino' inmediatamente después de 'loc', o al principio si
+    'loc' es NULL. 'destino' puede ser la misma cadena si 'loc' no está en el
+    segmento.
+    El tiempo de ejecución en el peor caso es O(1), u O(k) si se lleva la
+    cantidad de elementos, siendo 'k' la cantidad de nodos del segmento.
+  */
+  void moverSegmento(Nodo *desde, Nodo *hasta, TCadenaT &destino, Nodo *loc) {
+    desenlazarSegmento(desde, hasta);
+    destino.enlazarNodosDespues(desde, hasta, loc);
+    if constexpr (Politica::CONTAR)
+      destino.sumar(largoSegmento(desde, hasta));
+  }
+
+  /*
+    Invierte el orden de los nodos intercambiando los enlaces de cada uno.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  void invertirEnlaces(nat &recorridos) {
+    for (Nodo *loc = inicio; loc != NULL; loc = loc->anterior) {
+      Nodo *aux = loc->siguiente;
+      loc->siguiente = loc->anterior;
+      loc->anterior = aux;
+      recorridos++;
+    }
+    Nodo *aux = inicio;
+    inicio = final;
+    final = aux;
+  }
+
+  // ------------------------------------------------------------------
+  // Elementos.
+
+  /*
+    Inserta 'dato' al final en un nodo nuevo, que devuelve. Los argumentos
+    'args' se pasan a 'Politica::crearNodo'.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  template <class... Args> Nodo *insertarAlFinal(const T &dato, Args... args) {
+    Nodo *nuevo = Politica::crearNodo(args...);
+    nuevo->dato = dato;
+    enlazarAlFinal(nuevo);
+    return nuevo;
+  }
+
+  /*
+    Inserta 'dato' inmediatamente antes de 'loc' en un nodo nuevo, que
+    devuelve. Los argumentos 'args' se pasan a 'Politica::crearNodo'.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  template <class... Args>
+  Nodo *insertarAntes(const T &dato, Nodo *loc, Args... args) {
+    Nodo *nuevo = Politica::crearNodo(args...);
+    nuevo->dato = dato;
+    enlazarAntes(nuevo, loc);
+    return nuevo;
+  }
+
+  /*
+    Desenlaza y libera 'loc'.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  void remover(Nodo *loc) {
+    desenlazar(loc);
+    Politica::liberarNodo(loc);
+  }
+
+  /*
+    Libera todos los nodos.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  void vaciar() {
+    while (inicio != NULL) {
+      Nodo *borrar = inicio;
+      inicio = inicio->siguiente;
+      Politica::liberarNodo(borrar);
+    }
+    final = NULL;
+    this->restar(cantidadActual());
+  }
+
+  // ------------------------------------------------------------------
+  // Posiciones.
+
+  /*
+    Devuelve el nodo de la posición 'k' (el primero es el 1), o NULL si 'k'
+    es 0 o mayor a la cantidad de elementos.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  Nodo *kesimo(nat k, nat &recorridos) const {
+    Nodo *res = NULL;
+    if (k > 0) {
+      if (Politica::CONTAR && (k > cantidadActual() / 2)) {
+        // desde el final, si se sabe cuántos hay
+        if (k <= cantidadActual()) {
+          res = final;
+          for (nat i = cantidadActual(); i > k; i--) {
+            res = res->anterior;
+            recorridos++;
+          }
+        }
+      } else {
+        res = inicio;
+        for (nat i = 1; (res != NULL) && (i < k); i++) {
+          res = res->siguiente;
+          recorridos++;
+        }
+      }
+    }
+    return res;
+  }
+
+  /*
+    Devuelve 'true' si y solo si 'loc' es un nodo de la cadena.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  bool contiene(const Nodo *loc, nat &recorridos) const {
+    return precedeDesde(inicio, loc, recorridos);
+  }
+
+  /*
+    Devuelve 'true' si y solo si 'loc2' es 'desde' o alguno de los nodos
+    siguientes.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  static bool precedeDesde(const Nodo *desde, const Nodo *loc2,
+                           nat &recorridos) {
+    const Nodo *cursor = desde;
+    while ((cursor != NULL) && (cursor != loc2)) {
+      cursor = cursor->siguiente;
+      recorridos++;
+    }
+    return cursor != NULL;
+  }
+
+  // ------------------------------------------------------------------
+  // Claves.
+
+  /*
+    Devuelve el primer nodo desde 'loc' (inclusive) hacia el final cuya
+    clave es 'clave', o NULL si no hay.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  template <class Clave = typename Politica::Clave>
+  static Nodo *buscarAdelante(nat clave, Nodo *loc, nat &recorridos) {
+    while ((loc != NULL) && (Clave::clave(loc->dato) != clave)) {
+      loc = loc->siguiente;
+      recorridos++;
+    }
+    return loc;
+  }
+
+  /*
+    Devuelve el primer nodo desde 'loc' (inclusive) hacia el inicio cuya
+    clave es 'clave', o NULL si no hay.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  template <class Clave = typename Politica::Clave>
+  static Nodo *buscarAtras(nat clave, Nodo *loc, nat &recorridos) {
+    while ((loc != NULL) && (Clave::clave(loc->dato) != clave)) {
+      loc = loc->anterior;
+      recorridos++;
+    }
+    return loc;
+  }
+
+  /*
+    Devuelve el primer nodo de menor clave desde 'loc' hasta el final.
+    Precondición: 'loc' no es NULL.
+    El tiempo de ejecución en el peor caso es O(n).
+  */
+  template <class Clave = typename Politica::Clave>
+  static Nodo *menor(Nodo *loc, nat &recorridos) {
+    Nodo *res = loc;
+    nat minimo = Clave::clave(loc->dato);
+    for (loc = loc->siguiente; loc != NULL; loc = loc->siguiente) {
+      nat c = Clave::clave(loc->dato);
+      if (c < minimo) {
+        minimo = c;
+        res = loc;
+      }
+      recorridos++;
+    }
+    return res;
+  }
+
+  /*
+    Mueve los nodos de 'otra' a esta cadena y deja vacía a 'otra'. Si las dos
+    están ordenadas de manera no decreciente según su clave el resultado
+    también lo está, y los nodos de 'otra' quedan después de los de esta
+    cadena con la misma clave. No se obtienen nodos: cada tramo de 'otra' que
+    va entre dos nodos de esta cadena se enlaza entero.
+    'galope(clave, loc)' devuelve el primer nodo desde 'loc' (inclusive) cuya
+    clave es mayor a 'clave', o NULL si no hay. 'movido(primero, ultimo)' se
+    invoca con cada tramo después de enlazarlo.
+    El tiempo de ejecución en el peor caso es O(n2) más lo que cuestan
+    'galope' y 'movido', siendo 'n2' la cantidad de nodos de 'otra'.
+  */
+  template <class Clave = typename Politica::Clave, class Galope, class Movido>
+  void mezclar(TCadenaT &otra, Galope galope, Movido movido, nat &recorridos) {
+    Nodo *loc = inicio;
+    while (!otra.esVacia()) {
+      Nodo *primero = otra.inicio;
+      loc = galope(Clave::clave(primero->dato), loc);
+      // el tramo de 'otra' que va antes de 'loc'
+      Nodo *ultimo;
+      nat k = 1;
+      if (loc == NULL) {
+        ultimo = otra.final;
+        k = otra.cantidadActual();
+      } else {
+        nat c = Clave::clave(loc->dato);
+        ultimo = primero;
+        while ((ultimo->siguiente != NULL) &&
+               (Clave::clave(ultimo->siguiente->dato) < c)) {
+          ultimo = ultimo->siguiente;
+          k++;
+          recorridos++;
+        }
+      }
+      otra.inicio = ultimo->siguiente;
+      if (otra.inicio == NULL)
+        otra.final = NULL;
+      else
+        otra.inicio->anterior = NULL;
+      otra.restar(k);
+      Nodo *antes = (loc == NULL) ? final : loc->anterior;
+      primero->anterior = antes;
+      ultimo->siguiente = loc;
+      if (antes == NULL)
+        inicio = primero;
+      else
+        antes->siguiente = primero;
+      if (loc == NULL)
+        final = ultimo;
+      else
+        loc->anterior = ultimo;
+      this->sumar(k);
+      movido(primero, ultimo);
+      recorridos++;
+    }
+  }
+
+  /*
+    Como el anterior, avanzando por los nodos de esta cadena.
+    El tiempo de ejecución en el peor caso es O(n1 + n2).
+  */
+  template <class Clave = typename Politica::Clave>
+  void mezclar(TCadenaT &otra, nat &recorridos) {
+    mezclar<Clave>(
+        otra,
+        [&recorridos](nat clave, Nodo *loc) {
+          while ((loc != NULL) && (Clave::clave(loc->dato) <= clave)) {
+            loc = loc->siguiente;
+            recorridos++;
+          }
+          return loc;
+        },
+        [](Nodo *, Nodo *) {}, recorridos);
+  }
+
+  /*
+    Ordena los elementos de manera creciente según su clave, moviendo los
+    elementos entre los nodos (los nodos no cambian de posición). El orden
+    entre elementos de igual clave se mantiene.
+    Con hasta TAM_RED elementos se usa una red de ordenamiento y si no
+    ordenamiento por inserción.
+    El tiempo de ejecución en el peor caso es O(n^2).
+  */
+  template <class Clave = typename Politica::Clave>
+  void ordenar(nat &recorridos) {
+    if (!ordenarConRed<Clave>(recorridos))
+      ordenarPorInsercion<Clave>(recorridos);
+  }
+
+  /*
+    Si hay a lo sumo TAM_RED elementos los ordena con RED_ORDENAMIENTO y
+    devuelve 'true'. Si no, devuelve 'false' sin modificar la cadena.
+    El tiempo de ejecución en el peor caso es O(1).
+  */
+  template <class Clave = typename Politica::Clave>
+  bool ordenarConRed(nat &recorridos) {
+    // cada clave lleva en los bits bajos la posición original, para que no
+    // haya claves iguales y el orden resultante sea estable
+    uint64_t claves[TAM_RED];
+    Nodo *nodos[TAM_RED];
+    nat k = 0;
+    Nodo *loc = inicio;
+    while ((loc != NULL) && (k < TAM_RED)) {
+      claves[k] = ((uint64_t)Clave::clave(loc->dato) << 4) | k;
+      nodos[k] = loc;
+      loc = loc->siguiente;
+      k++;
+    }
+    recorridos += k;
+    bool res = (loc == NULL);
+    if (res) {
+      for (const unsigned char *par : RED_ORDENAMIENTO) {
+        if (par[1] < k) {
+          uint64_t a = claves[par[0]], b = claves[par[1]];
+          claves[par[0]] = (a < b) ? a : b;
+          claves[par[1]] = (a < b) ? b : a;
+        }
+      }
+      T datos[TAM_RED];
+      for (nat i = 0; i < k; i++)
+        datos[i] = nodos[i]->dato;
+      for (nat i = 0; i < k; i++)
+        nodos[i]->dato = datos[claves[i] & 0xF];
+    }
+    return res;
+  }
+
+  /*
+    Ordena los elementos por inserción.
+    El tiempo de ejecución en el peor caso es O(n^2).
+  */
+  template <class Clave = typename Politica::Clave>
+  void ordenarPorInsercion(nat &recorridos) {
+    for (Nodo *loc = (inicio == NULL) ? NULL : inicio->siguiente; loc != NULL;
+         loc = loc->siguiente) {
+      T dato = loc->dato;
+      nat clave = Clave::clave(dato);
+      Nodo *hueco = loc;
+      while ((hueco != inicio) && (Clave::clave(hueco->anterior->dato) > clave)) {
+        hueco->dato = hueco->anterior->dato;
+        hueco = hueco->anterior;
+        recorridos++;
+      }
+      hueco->dato = dato;
+      recorridos++;
+    }
+  }
+
+private:
+  nat cantidadActual() const {
+    if constexpr (Politica::CONTAR)
+      return this->cantidad;
+    else
+      return 0;
+  }
+
+  static nat largoSegmento(const Nodo *desde, const Nodo *hasta) {
+    nat k = 1;
+    for (const Nodo *loc = desde; loc != hasta; loc = loc->siguiente)
+      k++;
+    return k;
+  }
+
+  /*
+    Enlaza los nodos que van desde 'primero' hasta 'ultimo', ya enlazados
+    entre sí, inmediatamente después de 'loc', o al principio si 'loc' es
+    NULL. No actualiza la cantidad de elementos.
+  */
+  void enlazarNodosDespues(Nodo *primero, Nodo *ultimo, Nodo *loc) {
+    Nodo *despues = (loc == NULL) ? inicio : loc->siguiente;
+    primero->anterior = loc;
+    ultimo->siguiente = despues;
+    if (loc == NULL)
+      inicio = primero;
+    else
+      loc->siguiente = primero;
+    if (despues == NULL)
+      final = ultimo;
+    else
+      despues->anterior = ultimo;
+  }
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+  Módulo de definición de 'epocas'.
+
+  Recuperación de memoria basada en épocas. Los elementos que se quitan de una
+  estructura no se liberan de inmediato sino que se retiran, y se liberan
+  recién cuando todos los lectores que estaban activos en el momento de
+  retirarlos terminaron su recorrido.
+
+  Los lectores no esperan nunca: solo anuncian la época en la que empiezan a
+  recorrer. Las operaciones de escritura sobre una misma estructura se asumen
+  serializadas por quien las invoca.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _EPOCAS_H
+#define _EPOCAS_H
+
+#include "utils.h"
+
+// Cantidad máxima de hilos lectores registrados a la vez. Un hilo queda
+// registrado desde su primer 'entrarLectura' hasta que termina.
+#define MAX_LECTORES 64
+
+/*
+  Función que libera un elemento retirado. Recibe el elemento y el contexto con
+  el que fue retirado.
+*/
+typedef void (*TLiberador)(void *elem, void *contexto);
+
+/*
+  Marca el comienzo de un recorrido de solo lectura en el hilo actual.
+  Los elementos retirados a partir de este momento no se liberan hasta que
+  se invoque 'salirLectura'.
+  Las llamadas se pueden anidar.
+  Si el hilo no está registrado y ya hay MAX_LECTORES registrados, el programa
+  aborta.
+  El tiempo de ejecución en el peor caso es O(1), salvo la primera llamada de
+  cada hilo que es O(MAX_LECTORES).
+*/
+void entrarLectura();
+
+/*
+  Marca el final del recorrido iniciado con 'entrarLectura'.
+  Precondición: hay un recorrido abierto en el hilo actual.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+void salirLectura();
+
+/*
+  Retira 'elem', que ya no es alcanzable desde la estructura que lo contenía.
+  'liberador' se invoca con 'elem' y 'contexto' cuando ningún lector que
+  pudiera estar accediendo a 'elem' siga activo. Si no hay lectores activos
+  se invoca inmediatamente.
+  'liberador' no puede invocar a 'retirar'.
+  El tiempo de ejecución en el peor caso es O(MAX_LECTORES) más el de las
+  liberaciones que se habiliten.
+*/
+void retirar(void *elem, void *contexto, TLiberador liberador);
+
+/*
+  Libera los elementos retirados que ya no pueden ser accedidos por ningún
+  lector activo.
+  El tiempo de ejecución en el peor caso es O(MAX_LECTORES + r), siendo 'r' la
+  cantidad de elementos retirados pendientes.
+*/
+void reclamar();
+
+/*
+  Devuelve la cantidad de elementos retirados que todavía no fueron liberados.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+nat profundidadRetiro();
+
+#endif
@@ -0,0 +1,226 @@
+/*
+  Módulo de definición de 'estadisticas'.
+
+  Contadores de las operaciones de 'cadena' y 'usoTads': cuántas veces se
+  invoca cada una, cuántos nodos recorre cada una en sus propias iteraciones
+  (sin contar los que recorren las operaciones que invoca), cuántos 'TInfo'
+  se crean y se liberan, y cuántos bytes ocupan los nodos, cabezales y
+  'TInfo' en uso.
+
+  Cada hilo cuenta en sus propios contadores, por lo que contar no requiere
+  sincronización; las consultas suman los de todos los hilos.
+
+  Si se compila con SIN_ESTADISTICAS las funciones que cuentan no hacen nada
+  (y el compilador las elimina), las consultas devuelven 0 y
+  'hayEstadisticas' devuelve 'false'.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _ESTADISTICAS_H
+#define _ESTADISTICAS_H
+
+#include "salida.h"
+#include "utils.h"
+
+enum TOperacion {
+  // cadena
+  opEsLocalizador,
+  opCrearCadena,
+  opLiberarCadena,
+  opEsVaciaCadena,
+  opInicioCadena,
+  opFinalCadena,
+  opInfoCadena,
+  opSiguiente,
+  opAnterior,
+  opEsFinalCadena,
+  opEsInicioCadena,
+  opInsertarAlFinal,
+  opInsertarAntes,
+  opRemoverDeCadena,
+  opImprimirCadena,
+  opKesimo,
+  opLocalizadorEnCadena,
+  opPrecedeEnCadena,
+  opInsertarSegmentoDespues,
+  opCopiarSegmento,
+  opBorrarSegmento,
+  opCambiarEnCadena,
+  opIntercambiar,
+  opSiguienteClave,
+  opAnteriorClave,
+  opMenorEnCadena,
+  opOrdenarCadena,
+  opIndexarCadena,
+  opEstaIndexada,
+  opInsertarOrdenado,
+  opBuscarClave,
+  opCotaInferior,
+  opCotaSuperior,
+  opGaloparClave,
+  opContarEnRango,
+  opSumaReales,
+  opMinReal,
+  opMaxReal,
+  opMezclar,
+  opUnirCadenas,
+  opIntersecarCadenas,
+  opRestarCadenas,
+  opEliminarRepetidos,
+  opFiltrarCadena,
+  opParticionarCadena,
+  opFiltrarRango,
+  opParticionarRango,
+  opInvertirCadena,
+  opNormalizar,
+  opPartirCadena,
+  opMoverSegmento,
+  // usoTads
+  opPertenece,
+  opLongitud,
+  opEstaOrdenadaPorNaturales,
+  opHayNatsRepetidos,
+  opSonIgualesCadena,
+  opConcatenar,
+  opOrdenar,
+  opCambiarTodos,
+  opSubCadena,
+  opUnionCadenas,
+  opInterseccionCadenas,
+  opDiferenciaCadenas,
+  CANT_OPERACIONES
+};
+
+#ifndef SIN_ESTADISTICAS
+
+#include <stddef.h>
+
+#include <atomic>
+
+// Contadores de un hilo. Se declaran aquí para que contar se expanda en
+// línea; solo los modifica el hilo dueño, y las consultas los leen.
+struct repContadores {
+  std::atomic<unsigned long> llamadas[CANT_OPERACIONES];
+  std::atomic<unsigned long> nodos[CANT_OPERACIONES];
+  std::atomic<unsigned long> infosCreadas;
+  std::atomic<unsigned long> infosLiberadas;
+  std::atomic<long> bytes;
+  repContadores *siguiente;
+};
+
+extern thread_local repContadores *contadoresDelHilo;
+
+/*
+  Crea y registra los contadores del hilo actual.
+*/
+repContadores *registrarContadores();
+
+inline repContadores &contadores() {
+  repContadores *res = contadoresDelHilo;
+  return (res != NULL) ? *res : *registrarContadores();
+}
+
+template <class T> inline void sumarContador(std::atomic<T> &c, T cant) {
+  // solo escribe el hilo dueño: no hace falta una suma atómica
+  c.store(c.load(std::memory_order_relaxed) + cant, std::memory_order_relaxed);
+}
+
+/*
+  Cuenta una invocación de 'op'.
+*/
+inline void contarLlamada(TOperacion op) {
+  sumarContador(contadores().llamadas[op], 1ul);
+}
+
+/*
+  Cuenta 'cant' nodos recorridos por 'op'.
+*/
+inline void contarNodos(TOperacion op, nat cant) {
+  sumarContador(contadores().nodos[op], (unsigned long)cant);
+}
+
+/*
+  Cuenta 'bytes' bytes más en uso ('bytes' es negativo si se liberan).
+*/
+inline void contarBytes(long bytes) { sumarContador(contadores().bytes, bytes); }
+
+/*
+  Cuenta un 'TInfo' creado que ocupa 'bytes' bytes.
+*/
+inline void contarInfoCreado(long bytes) {
+  repContadores &c = contadores();
+  sumarContador(c.infosCreadas, 1ul);
+  sumarContador(c.bytes, bytes);
+}
+
+/*
+  Cuenta un 'TInfo' liberado que ocupaba 'bytes' bytes.
+*/
+inline void contarInfoLiberado(long bytes) {
+  repContadores &c = contadores();
+  sumarContador(c.infosLiberadas, 1ul);
+  sumarContador(c.bytes, -bytes);
+}
+
+#else
+
+inline void contarLlamada(TOperacion) {}
+inline void contarNodos(TOperacion, nat) {}
+inline void contarBytes(long) {}
+inline void contarInfoCreado(long) {}
+inline void contarInfoLiberado(long) {}
+
+#endif
+
+/*
+  Devuelve 'true' si y solo si el programa se compiló con los contadores.
+*/
+bool hayEstadisticas();
+
+/*
+  Devuelve el nombre de la función de 'op' (por ejemplo "kesimo").
+*/
+const char *nombreOperacion(TOperacion op);
+
+/*
+  Devuelve la cantidad de invocaciones de 'op'.
+*/
+unsigned long llamadasOperacion(TOperacion op);
+
+/*
+  Devuelve la cantidad de nodos recorridos por 'op'.
+*/
+unsigned long nodosOperacion(TOperacion op);
+
+/*
+  Devuelve la cantidad de 'TInfo' creados.
+*/
+unsigned long infosCreadas();
+
+/*
+  Devuelve la cantidad de 'TInfo' liberados.
+*/
+unsigned long infosLiberadas();
+
+/*
+  Devuelve la cantidad de bytes de nodos, cabezales y 'TInfo' en uso.
+*/
+long bytesEnUso();
+
+/*
+  Pone en 0 los contadores de llamadas y de nodos recorridos. Los de 'TInfo'
+  y de bytes se conservan porque describen la memoria en uso.
+  Con varios hilos contando a la vez se puede perder parte del reinicio.
+*/
+void reiniciarEstadisticas();
+
+/*
+  Agrega a 'buf' una tabla con las llamadas y nodos recorridos de cada
+  operación invocada al menos una vez, seguida de los contadores de 'TInfo'
+  y de bytes en uso.
+*/
+void imprimirEstadisticasEnBuffer(TBufferSalida buf);
+
+#endif
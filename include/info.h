@@ -11,8 +11,15 @@
 #ifndef _INFO_H
 #define _INFO_H
 
+#include "memoria.h"
 #include "utils.h"
 
+#include <stddef.h> // size_t
+
+// Cantidad máxima de caracteres, incluido el '\0' final, que ocupa el texto
+// de un 'TInfo' (ver 'infoATextoEn').
+#define MAX_TEXTO_INFO 336
+
 // Representación de 'TInfo'.
 // Se debe definir en info.cpp.
 // struct repInfo;
@@ -21,21 +28,25 @@ typedef struct repInfo *TInfo;
 
 /* Operaciones de TInfo */
 
+// El parámetro 'lugar' de las funciones que reservan o liberan memoria es el
+// lugar de la llamada; se usa solo en el control de 'memoria' y no se pasa
+// explícitamente.
+
 /*
   Devuelve un 'TInfo' compuesto por 'natural' y 'real'.
 */
-TInfo crearInfo(nat natural, double real);
+TInfo crearInfo(nat natural, double real, TLugar lugar = TLugar::actual());
 
 /*
   Libera la memoria reservada por 'info'.
 */
-void liberarInfo(TInfo info);
+void liberarInfo(TInfo info, TLugar lugar = TLugar::actual());
 
 /*
   Devuelve una copia de 'info'.
   El elemento devuelto no comparte memoria con 'info'.
 */
-TInfo copiaInfo(TInfo info);
+TInfo copiaInfo(TInfo info, TLugar lugar = TLugar::actual());
 
 /*
   Devuelve el componente natural de 'info'.
@@ -63,7 +74,33 @@ bool sonIgualesInfo(TInfo i1, TInfo i2);
   (4,2.0)
   (9,-1.2)
   (0,0)
+  El arreglo devuelto se libera con 'liberarTextoInfo'.
+*/
+ArregloChars infoATexto(TInfo info, TLugar lugar = TLugar::actual());
+
+/*
+  Libera el arreglo 'texto' devuelto por 'infoATexto'.
+*/
+void liberarTextoInfo(ArregloChars texto, TLugar lugar = TLugar::actual());
+
+/*
+  Escribe en 'buf' el mismo texto que devuelve 'infoATexto(info)', terminado
+  con '\0', y devuelve su largo (sin contar el '\0').
+  No se obtiene memoria de manera dinámica.
+  Si el texto no entra en los 'cap' caracteres de 'buf' devuelve 0 y, si
+  'cap' > 0, deja en 'buf' el texto vacío.
+  Con 'cap' >= MAX_TEXTO_INFO el texto siempre entra.
+*/
+size_t infoATextoEn(TInfo info, char *buf, size_t cap);
+
+/*
+  Escribe en 'buf' la concatenación de los textos de los 'cantidad' elementos
+  de 'infos', terminada con '\0', y devuelve su largo (sin contar el '\0').
+  No se obtiene memoria de manera dinámica.
+  Si el texto no entra en los 'cap' caracteres de 'buf' devuelve 0 y, si
+  'cap' > 0, deja en 'buf' el texto vacío.
+  Con 'cap' >= cantidad * MAX_TEXTO_INFO el texto siempre entra.
 */
-ArregloChars infoATexto(TInfo info);
+size_t infosATextoEn(const TInfo *infos, nat cantidad, char *buf, size_t cap);
 
 #endif
@@ -0,0 +1,34 @@
+/*
+  Representación de 'TInfo' para los módulos que la necesitan en línea.
+
+  No es parte de la interfaz de 'info': la incluyen solo info.cpp, que define
+  ahí la estructura, y cadena.cpp, que lee los componentes de cada elemento
+  con 'natInfoEnLinea' y 'realInfoEnLinea' en las comparaciones de claves y
+  los recorridos, para no llamar a 'natInfo' y 'realInfo' en cada nodo.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _INFO_INTERNA_H
+#define _INFO_INTERNA_H
+
+#include "info.h"
+#include "utils.h"
+
+struct repInfo {
+  nat n;
+  double r;
+};
+
+/*
+  Devuelve el componente natural de 'info', como 'natInfo'.
+*/
+inline nat natInfoEnLinea(TInfo info) { return info->n; }
+
+/*
+  Devuelve el componente real de 'info', como 'realInfo'.
+*/
+inline double realInfoEnLinea(TInfo info) { return info->r; }
+
+#endif
@@ -0,0 +1,81 @@
+/*
+  Módulo de definición de 'interprete'.
+
+  Se ejecutan los comandos con los que se prueban los módulos (ver
+  'principal.cpp'). Cada 'TSesion' tiene su propia 'TCadena' 'cad' y su propio
+  'TLocalizador' 'loc'.
+
+  Los nombres de los comandos se resuelven con una tabla de dispersión
+  perfecta que se arma en tiempo de compilación, por lo que el costo de
+  encontrar un comando no depende de su posición en la tabla.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _INTERPRETE_H
+#define _INTERPRETE_H
+
+#include "salida.h"
+#include "utils.h"
+
+// Representación de 'TSesion'.
+// Se define en interprete.cpp.
+// struct repSesion;
+// Declaración del tipo 'TSesion'
+typedef struct repSesion *TSesion;
+
+/*
+  Devuelve una 'TSesion' con 'cad' vacía y 'loc' no válido.
+*/
+TSesion crearSesion();
+
+/*
+  Devuelve una 'TSesion' como la de 'crearSesion' que, en lugar de imprimir en
+  la salida estándar, agrega lo que imprimen sus comandos al final de 'buf'.
+  La 'TSesion' no se adueña de 'buf'.
+  Como los comandos llegan de un cliente, sus precondiciones se verifican: si
+  un comando no las cumple se agrega a 'buf' una línea "Error: ..." y no se
+  ejecuta. Tampoco se aceptan cadenas de más de 65536 elementos ni los
+  comandos que usan archivos ('guardarCadena' y 'cargarCadena').
+*/
+TSesion crearSesionRemota(TBufferSalida buf);
+
+/*
+  Libera la memoria asignada a 's' y a sus estructuras.
+*/
+void liberarSesion(TSesion s);
+
+/*
+  Devuelve 'true' si y solo si en 's' ya se ejecutó el comando 'Fin'.
+*/
+bool terminoSesion(TSesion s);
+
+/*
+  Ejecuta en 's' el comando 'nombre', leyendo sus parámetros con las funciones
+  de lectura de 'utils' e imprimiendo su resultado en la salida de 's'.
+  Si 'nombre' no es un comando imprime "Comando no reconocido.".
+  No consume el resto de la línea.
+*/
+void ejecutarComando(const char *nombre, TSesion s);
+
+/*
+  Devuelve la cantidad de comandos.
+*/
+nat cantidadComandos();
+
+/*
+  Devuelve el nombre del 'k'-ésimo comando de la tabla.
+  Precondición: 1 <= k <= cantidadComandos().
+*/
+const char *nombreComando(nat k);
+
+/*
+  Devuelve la posición en la tabla del comando 'nombre', o 0 si no hay un
+  comando con ese nombre.
+  El tiempo de ejecución en el peor caso es O(m), siendo 'm' el largo de
+  'nombre'.
+*/
+nat buscarComando(const char *nombre);
+
+#endif
@@ -0,0 +1,82 @@
+/*
+  Módulo de definición de 'memoria'.
+
+  Control de la memoria de nodos, 'TInfo', textos de 'infoATexto' e índices
+  de cadenas ordenadas. Cada reserva se registra con su tipo y el lugar
+  (archivo y línea) desde el que se pidió, y cada liberación se verifica
+  contra lo registrado. Al terminar el
+  programa se informa en la salida de errores qué quedó sin liberar,
+  agrupado por tipo y lugar, y qué liberaciones fueron inválidas (dobles, de
+  memoria no registrada o con un tipo distinto al de la reserva). Si no hubo
+  problemas no se informa nada.
+
+  El control se compila solo si está definido CONTROL_MEMORIA. Si no lo está
+  las funciones de registro no hacen nada y el compilador las elimina.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _MEMORIA_H
+#define _MEMORIA_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+enum TTipoMemoria {
+  memNodo,
+  memInfo,
+  memTextoInfo,
+  memIndice,
+  CANT_TIPOS_MEMORIA
+};
+
+/*
+  Lugar del código fuente.
+  Usado como argumento por defecto, 'TLugar::actual()' es el lugar de la
+  llamada a la función que lo declara, lo que permite atribuir una reserva a
+  quien invocó, por ejemplo, 'crearInfo'.
+*/
+struct TLugar {
+  const char *archivo;
+  nat linea;
+
+  static TLugar actual(const char *archivo = __builtin_FILE(),
+                       nat linea = __builtin_LINE()) {
+    TLugar res = {archivo, linea};
+    return res;
+  }
+};
+
+#ifdef CONTROL_MEMORIA
+
+/*
+  Registra que se reservaron 'bytes' bytes de tipo 'tipo' en 'p' desde
+  'lugar'.
+  Precondición: 'p' no está registrado.
+  El tiempo de ejecución es O(1) en promedio.
+*/
+void registrarReserva(const void *p, size_t bytes, TTipoMemoria tipo,
+                      TLugar lugar);
+
+/*
+  Registra que se libera 'p', de tipo 'tipo', desde 'lugar'.
+  Devuelve 'true' si 'p' estaba registrado con tipo 'tipo', y en ese caso
+  deja de estarlo. Si no, registra la liberación inválida y devuelve
+  'false': quien invoca no debe liberar 'p'.
+  Si 'p' es NULL no hace nada y devuelve 'true'.
+  El tiempo de ejecución es O(1) en promedio.
+*/
+bool registrarLiberacion(const void *p, TTipoMemoria tipo, TLugar lugar);
+
+#else
+
+inline void registrarReserva(const void *, size_t, TTipoMemoria, TLugar) {}
+inline bool registrarLiberacion(const void *, TTipoMemoria, TLugar) {
+  return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+/*
+  Módulo de definición de 'persistencia'.
+
+  Se guardan y cargan elementos de tipo 'TCadena' en archivos binarios.
+
+  Formato del archivo (versión 1), con los enteros en el orden de bytes de la
+  máquina:
+  - cabezal de 32 bytes: la marca "CADB", la versión (4 bytes), las banderas
+    (4 bytes), 4 bytes reservados, la cantidad de elementos (8 bytes) y el
+    desplazamiento del índice desde el inicio del archivo (8 bytes, 0 si no
+    hay índice);
+  - un registro de 12 bytes por elemento, en el orden de la cadena: el
+    componente natural (4 bytes) seguido del componente real (8 bytes);
+  - opcionalmente, el índice: las posiciones (base 0, 4 bytes cada una) de
+    los registros ordenadas de manera creciente según el componente natural,
+    y entre registros con igual natural según la posición.
+
+  Los archivos se cargan proyectándolos en memoria con 'mmap', por lo que los
+  elementos se leen sin interpretar texto.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _PERSISTENCIA_H
+#define _PERSISTENCIA_H
+
+#include "cadena.h"
+#include "utils.h"
+
+// Versión del formato que se escribe y la única que se puede leer.
+#define VERSION_ARCHIVO_CADENA 1
+
+// Cadena de solo lectura servida directamente desde un archivo proyectado.
+// Representación de 'TCadenaMapeada'.
+// Se define en persistencia.cpp.
+// struct repCadenaMapeada;
+// Declaración del tipo 'TCadenaMapeada'
+typedef struct repCadenaMapeada *TCadenaMapeada;
+
+/*
+  Guarda los elementos de 'cad' en 'archivo' con el formato descrito arriba.
+  Si 'conIndice' se agrega el índice por componente natural.
+  Devuelve 'true' si y solo si se pudo escribir el archivo completo.
+  El tiempo de ejecución en el peor caso es O(n) sin índice y O(n log n) con
+  índice, siendo 'n' la cantidad de elementos de 'cad'.
+*/
+bool guardarCadena(const char *archivo, bool conIndice, TCadena cad);
+
+/*
+  Devuelve una 'TCadena' con los elementos guardados en 'archivo'.
+  La 'TCadena' resultado no comparte memoria con el archivo.
+  Si el archivo no existe o no tiene el formato esperado devuelve NULL.
+  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  elementos guardados.
+*/
+TCadena cargarCadena(const char *archivo);
+
+/*
+  Proyecta 'archivo' en memoria y devuelve una 'TCadenaMapeada' de solo
+  lectura sobre sus elementos.
+  Si el archivo no existe o no tiene el formato esperado devuelve NULL.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+TCadenaMapeada abrirCadenaMapeada(const char *archivo);
+
+/*
+  Libera la memoria asignada a 'map' y deshace la proyección del archivo.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+void cerrarCadenaMapeada(TCadenaMapeada map);
+
+/*
+  Devuelve la cantidad de elementos de 'map'.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+nat longitudMapeada(TCadenaMapeada map);
+
+/*
+  Devuelve el componente natural del 'k'-ésimo elemento de 'map'.
+  Precondición: 1 <= k <= longitudMapeada(map).
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+nat natMapeado(nat k, TCadenaMapeada map);
+
+/*
+  Devuelve el componente real del 'k'-ésimo elemento de 'map'.
+  Precondición: 1 <= k <= longitudMapeada(map).
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+double realMapeado(nat k, TCadenaMapeada map);
+
+/*
+  Devuelve la posición del primer elemento de 'map' cuyo componente natural
+  es 'clave', o 0 si no hay ninguno. Si el archivo tiene un índice con una
+  posición fuera de rango también puede devolver 0.
+  El tiempo de ejecución en el peor caso es O(log n) si el archivo tiene
+  índice y O(n) si no, siendo 'n' la cantidad de elementos de 'map'.
+*/
+nat buscarClaveMapeada(nat clave, TCadenaMapeada map);
+
+/*
+  Imprime los elementos de 'map' con el mismo formato que 'imprimirCadena'.
+  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  elementos de 'map'.
+*/
+void imprimirCadenaMapeada(TCadenaMapeada map);
+
+#endif
@@ -0,0 +1,93 @@
+/*
+  Módulo de definición de 'salida'.
+
+  Los elementos de tipo 'TBufferSalida' son arreglos de caracteres que crecen
+  a medida que se les agrega texto. Se usan para formatear la salida sin
+  'printf' y volcarla con pocas llamadas a 'write'.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _SALIDA_H
+#define _SALIDA_H
+
+#include "utils.h"
+
+#include <stdarg.h> // va_list
+
+// Representación de 'TBufferSalida'.
+// Se define en salida.cpp.
+// struct repBufferSalida;
+// Declaración del tipo 'TBufferSalida'
+typedef struct repBufferSalida *TBufferSalida;
+
+/*
+  Devuelve un 'TBufferSalida' vacío con lugar para 'capacidad' caracteres.
+  Precondición: capacidad > 0.
+*/
+TBufferSalida crearBufferSalida(nat capacidad);
+
+/*
+  Libera la memoria asignada a 'buf'.
+*/
+void liberarBufferSalida(TBufferSalida buf);
+
+/*
+  Devuelve la cantidad de caracteres que tiene 'buf'.
+*/
+nat largoBufferSalida(TBufferSalida buf);
+
+/*
+  Devuelve los caracteres de 'buf', terminados con '\0'.
+  El resultado comparte memoria con 'buf' y deja de ser válido al agregarle
+  texto.
+*/
+const char *textoBufferSalida(TBufferSalida buf);
+
+/*
+  Deja 'buf' vacío, conservando la memoria que tiene asignada.
+*/
+void vaciarBufferSalida(TBufferSalida buf);
+
+/*
+  Se agrega 'c' al final de 'buf'.
+*/
+void agregarCaracter(char c, TBufferSalida buf);
+
+/*
+  Se agregan los primeros 'largo' caracteres de 'cs' al final de 'buf'.
+*/
+void agregarChars(const char *cs, nat largo, TBufferSalida buf);
+
+/*
+  Se agrega al final de 'buf' la representación decimal de 'n' (como con
+  "%i").
+*/
+void agregarEntero(int n, TBufferSalida buf);
+
+/*
+  Se agrega al final de 'buf' la representación de 'r' con dos decimales (como
+  con "%.2f").
+*/
+void agregarReal2(double r, TBufferSalida buf);
+
+/*
+  Se agrega al final de 'buf' el texto que imprimiría 'printf' con 'formato'
+  y los parámetros siguientes.
+*/
+void agregarFormato(TBufferSalida buf, const char *formato, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/*
+  Como 'agregarFormato', con los parámetros en 'args'.
+*/
+void agregarFormatoV(TBufferSalida buf, const char *formato, va_list args);
+
+/*
+  Escribe todo el contenido de 'buf' en el descriptor 'fd' y lo deja vacío.
+  Devuelve 'true' si y solo si se pudo escribir todo.
+*/
+bool volcarBufferSalida(int fd, TBufferSalida buf);
+
+#endif
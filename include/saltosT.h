@@ -0,0 +1,496 @@
+/*
+  Plantilla de listas de saltos sobre los nodos de una cadena ordenada.
+
+  'TListaSaltosT<Nodo, Clave, Valor, Asignador>' es un índice sobre una
+  cadena de nodos 'Nodo' (con campos 'dato' y 'siguiente', ver cadenaT.h)
+  ordenada de manera no decreciente según 'Clave::clave(dato)'. La cadena
+  misma es el nivel más bajo; el índice agrega torres sobre algunos de sus
+  nodos. Cada nodo tiene una torre con probabilidad 1/4, y cada torre de
+  altura h llega a altura h + 1 con probabilidad 1/4, por lo que las
+  búsquedas recorren O(log n) torres y nodos en promedio.
+
+  Cada nivel de cada torre (y de la cabeza) guarda, además del enlace a la
+  siguiente torre de ese nivel, el resumen ('TResumenSaltos') de los valores
+  'Valor::valor(dato)' de los nodos que van desde el de la torre hasta el
+  anterior al de la siguiente torre del nivel. Con esos resúmenes 'resumir'
+  obtiene la cantidad, la suma, el mínimo y el máximo de los valores de un
+  rango de claves sin recorrer sus nodos.
+
+  Las torres guardan solo el puntero al nodo: la clave se obtiene del nodo,
+  por lo que no se debe cambiar la clave ni el valor de un nodo que puede
+  tener torre sin quitarlo antes del índice.
+
+  'Asignador' provee 'static void *reservar(size_t bytes)' y
+  'static void liberar(void *p, size_t bytes)' para la memoria de las
+  torres.
+
+  Las operaciones que recorren torres o nodos suman en 'recorridos' la
+  cantidad que avanzaron.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _SALTOST_H
+#define _SALTOST_H
+
+#include "utils.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Altura máxima de las torres: con probabilidad 1/4 por nivel alcanza para
+// 4^16 nodos.
+#define MAX_ALTURA_SALTOS 16
+
+/*
+  Cantidad, suma, mínimo y máximo de un conjunto de valores. El mínimo y el
+  máximo de un resumen sin valores no están definidos.
+*/
+struct TResumenSaltos {
+  nat cantidad;
+  double suma;
+  double minimo;
+  double maximo;
+
+  static TResumenSaltos vacio() { return TResumenSaltos{0, 0, 0, 0}; }
+
+  void agregar(double valor) {
+    if ((cantidad == 0) || (valor < minimo))
+      minimo = valor;
+    if ((cantidad == 0) || (valor > maximo))
+      maximo = valor;
+    cantidad++;
+    suma += valor;
+  }
+
+  void combinar(const TResumenSaltos &otro) {
+    if (otro.cantidad > 0) {
+      if ((cantidad == 0) || (otro.minimo < minimo))
+        minimo = otro.minimo;
+      if ((cantidad == 0) || (otro.maximo > maximo))
+        maximo = otro.maximo;
+      cantidad += otro.cantidad;
+      suma += otro.suma;
+    }
+  }
+
+  bool esIgual(const TResumenSaltos &otro) const {
+    return (cantidad == otro.cantidad) && (suma == otro.suma) &&
+           ((cantidad == 0) ||
+            ((minimo == otro.minimo) && (maximo == otro.maximo)));
+  }
+};
+
+template <class Nodo, class Clave, class Valor, class Asignador>
+struct TListaSaltosT {
+  struct Torre;
+
+  struct Nivel {
+    Torre *siguiente;
+    TResumenSaltos resumen;
+  };
+
+  struct Torre {
+    Nodo *nodo;
+    nat altura;
+    Nivel niveles[]; // 'altura' niveles
+  };
+
+  /*
+    Torres de cada nivel que preceden a un nodo. La obtienen 'quitar' y
+    'agregar' y la usa 'recalcular'.
+  */
+  struct Ubicacion {
+    Torre *previas[MAX_ALTURA_SALTOS];
+  };
+
+  TListaSaltosT() : cabeza(crearTorre(NULL, MAX_ALTURA_SALTOS)) {}
+
+  ~TListaSaltosT() {
+    vaciar();
+    liberarTorre(cabeza);
+  }
+
+  TListaSaltosT(const TListaSaltosT &) = delete;
+  TListaSaltosT &operator=(const TListaSaltosT &) = delete;
+
+  /*
+    Devuelve el primer nodo desde 'inicio' cuya clave es mayor o igual a
+    'clave', o NULL si no hay.
+    El tiempo de ejecución es O(log n) en promedio.
+  */
+  Nodo *cotaInferior(nat clave, Nodo *inicio, nat &recorridos) const {
+    return cota(clave, false, inicio, recorridos);
+  }
+
+  /*
+    Devuelve el primer nodo desde 'inicio' cuya clave es mayor a 'clave', o
+    NULL si no hay.
+    El tiempo de ejecución es O(log n) en promedio.
+  */
+  Nodo *cotaSuperior(nat clave, Nodo *inicio, nat &recorridos) const {
+    return cota(clave, true, inicio, recorridos);
+  }
+
+  /*
+    Devuelve el resumen de los valores de los nodos de la cadena que empieza
+    en 'inicio' cuyas claves están entre 'menor' y 'mayor', incluidos.
+    El tiempo de ejecución es O(log n) en promedio, más la cantidad de nodos
+    con clave 'menor' o 'mayor'.
+  */
+  TResumenSaltos resumir(nat menor, nat mayor, Nodo *inicio,
+                         nat &recorridos) const {
+    TResumenSaltos res = TResumenSaltos::vacio();
+    if (menor <= mayor) {
+      Torre *x = buscar(menor, false, NULL, recorridos);
+      Torre *t = x->niveles[0].siguiente; // primera con clave >= 'menor'
+      Nodo *loc = (x == cabeza) ? inicio : x->nodo;
+      while ((loc != NULL) && (clave(loc) < menor)) {
+        loc = loc->siguiente;
+        recorridos++;
+      }
+      // los nodos del rango anteriores a la primera torre del rango
+      while ((loc != NULL) && (clave(loc) <= mayor) &&
+             ((t == NULL) || (loc != t->nodo))) {
+        res.agregar(valor(loc));
+        loc = loc->siguiente;
+        recorridos++;
+      }
+      if ((loc != NULL) && (t != NULL) && (clave(loc) <= mayor)) {
+        // se avanza por el nivel más alto cuyo tramo queda en el rango
+        Torre *y = t;
+        bool avanza = true;
+        while (avanza) {
+          nat h = y->altura;
+          while ((h > 0) && ((y->niveles[h - 1].siguiente == NULL) ||
+                             (clave(y->niveles[h - 1].siguiente) > mayor)))
+            h--;
+          avanza = h > 0;
+          if (avanza) {
+            res.combinar(y->niveles[h - 1].resumen);
+            y = y->niveles[h - 1].siguiente;
+            recorridos++;
+          }
+        }
+        for (loc = y->nodo; (loc != NULL) && (clave(loc) <= mayor);
+             loc = loc->siguiente) {
+          res.agregar(valor(loc));
+          recorridos++;
+        }
+      }
+    }
+    return res;
+  }
+
+  /*
+    Agrega al índice 'nodo', que ya está enlazado en la cadena que empieza en
+    'inicio' y no tiene torre, y actualiza los resúmenes de los tramos que lo
+    contienen.
+    El tiempo de ejecución es O(log n) en promedio, más la cantidad de nodos
+    con la misma clave que 'nodo' que lo preceden.
+  */
+  void agregar(Nodo *nodo, Nodo *inicio, nat &recorridos) {
+    Ubicacion u;
+    ubicar(nodo, inicio, u, recorridos);
+    Torre *nueva = NULL;
+    nat h = alturaAlAzar();
+    if (h > 0) {
+      if (h > altura)
+        altura = h;
+      nueva = crearTorre(nodo, h);
+      for (nat i = 0; i < h; i++) {
+        nueva->niveles[i].siguiente = u.previas[i]->niveles[i].siguiente;
+        u.previas[i]->niveles[i].siguiente = nueva;
+      }
+    }
+    recalcular(u, nueva, inicio, recorridos);
+  }
+
+  /*
+    Quita las torres de los nodos que van desde 'desde' hasta 'hasta',
+    incluidos, en la cadena que empieza en 'inicio', y deja en 'u' las torres
+    que los preceden.
+    No actualiza los resúmenes: después de desenlazar los nodos, o de
+    cambiarlos, se debe invocar a 'recalcular' con 'u' o a 'agregar'.
+    El tiempo de ejecución es O(log n + k) en promedio, siendo 'k' la
+    cantidad de nodos quitados, más la cantidad de nodos con la misma clave
+    que 'desde' que lo preceden.
+  */
+  void quitar(const Nodo *desde, const Nodo *hasta, Nodo *inicio, Ubicacion &u,
+              nat &recorridos) {
+    ubicar(desde, inicio, u, recorridos);
+    Torre *t = u.previas[0]->niveles[0].siguiente;
+    bool fin = false;
+    for (const Nodo *loc = desde; !fin; loc = loc->siguiente) {
+      fin = (loc == hasta);
+      if ((t != NULL) && (loc == t->nodo)) {
+        // 't' es la siguiente de la previa en cada uno de sus niveles
+        for (nat i = 0; i < t->altura; i++)
+          u.previas[i]->niveles[i].siguiente = t->niveles[i].siguiente;
+        Torre *quitada = t;
+        t = t->niveles[0].siguiente;
+        liberarTorre(quitada);
+      }
+      recorridos++;
+    }
+    while ((altura > 0) && (cabeza->niveles[altura - 1].siguiente == NULL))
+      altura--;
+  }
+
+  /*
+    Actualiza los resúmenes de los tramos que empiezan en las torres de 'u',
+    obtenida con 'quitar', en la cadena que ahora empieza en 'inicio'.
+    El tiempo de ejecución es O(log n) en promedio.
+  */
+  void recalcular(const Ubicacion &u, Nodo *inicio, nat &recorridos) {
+    recalcular(u, NULL, inicio, recorridos);
+  }
+
+  /*
+    Pasa a 'resto', que no tiene torres, las torres de los nodos que van desde
+    'primero' hasta el final de la cadena que empieza en 'inicio'. Deja en
+    'u' las torres que preceden a 'primero' y en 'ur' la cabeza de 'resto'.
+    No actualiza los resúmenes: después de separar la cadena en la que
+    termina antes de 'primero' y la que empieza en 'primero' se debe invocar
+    a 'recalcular' con 'u' y a 'resto.recalcular' con 'ur'.
+    El tiempo de ejecución es O(log n) en promedio, más la cantidad de nodos
+    con la misma clave que 'primero' que lo preceden.
+  */
+  void partir(const Nodo *primero, Nodo *inicio, TListaSaltosT &resto,
+              Ubicacion &u, Ubicacion &ur, nat &recorridos) {
+    ubicar(primero, inicio, u, recorridos);
+    for (nat h = 0; h < MAX_ALTURA_SALTOS; h++) {
+      resto.cabeza->niveles[h].siguiente = u.previas[h]->niveles[h].siguiente;
+      u.previas[h]->niveles[h].siguiente = NULL;
+      ur.previas[h] = resto.cabeza;
+    }
+    resto.altura = altura;
+    while ((altura > 0) && (cabeza->niveles[altura - 1].siguiente == NULL))
+      altura--;
+    while ((resto.altura > 0) &&
+           (resto.cabeza->niveles[resto.altura - 1].siguiente == NULL))
+      resto.altura--;
+  }
+
+  /*
+    Arma el índice de la cadena que empieza en 'inicio', descartando el
+    anterior.
+    El tiempo de ejecución es O(n) en promedio.
+  */
+  void construir(Nodo *inicio, nat &recorridos) {
+    vaciar();
+    Torre *ultimas[MAX_ALTURA_SALTOS];
+    for (nat i = 0; i < MAX_ALTURA_SALTOS; i++)
+      ultimas[i] = cabeza;
+    for (Nodo *loc = inicio; loc != NULL; loc = loc->siguiente) {
+      nat h = alturaAlAzar();
+      if (h > 0) {
+        if (h > altura)
+          altura = h;
+        Torre *nueva = crearTorre(loc, h);
+        for (nat i = 0; i < h; i++) {
+          ultimas[i]->niveles[i].siguiente = nueva;
+          ultimas[i] = nueva;
+        }
+      }
+      recorridos++;
+    }
+    for (nat h = 0; h < altura; h++)
+      for (Torre *x = cabeza; x != NULL; x = x->niveles[h].siguiente)
+        x->niveles[h].resumen = resumenTramo(x, h, inicio, recorridos);
+  }
+
+  /*
+    Quita todas las torres.
+    El tiempo de ejecución es O(n) en promedio.
+  */
+  void vaciar() {
+    Torre *t = cabeza->niveles[0].siguiente;
+    while (t != NULL) {
+      Torre *borrar = t;
+      t = t->niveles[0].siguiente;
+      liberarTorre(borrar);
+    }
+    for (nat i = 0; i < MAX_ALTURA_SALTOS; i++)
+      cabeza->niveles[i].siguiente = NULL;
+    altura = 0;
+  }
+
+  /*
+    Devuelve 'true' si y solo si la cadena que empieza en 'inicio' está
+    ordenada, cada torre está sobre un nodo de la cadena, en el orden de los
+    nodos, cada nivel está contenido en el de abajo y los resúmenes
+    corresponden a sus tramos.
+    Se usa para verificar el índice con 'assert'.
+    El tiempo de ejecución en el peor caso es O(n * MAX_ALTURA_SALTOS).
+  */
+  bool esConsistente(Nodo *inicio) const {
+    bool res = true;
+    const Torre *t = cabeza->niveles[0].siguiente;
+    for (const Nodo *loc = inicio; res && (loc != NULL); loc = loc->siguiente) {
+      res = (loc->siguiente == NULL) || (clave(loc) <= clave(loc->siguiente));
+      if ((t != NULL) && (t->nodo == loc))
+        t = t->niveles[0].siguiente;
+    }
+    res = res && (t == NULL);
+    for (nat h = 1; res && (h < MAX_ALTURA_SALTOS); h++) {
+      const Torre *abajo = cabeza->niveles[h - 1].siguiente;
+      for (const Torre *u = cabeza->niveles[h].siguiente; res && (u != NULL);
+           u = u->niveles[h].siguiente) {
+        while ((abajo != NULL) && (abajo != u))
+          abajo = abajo->niveles[h - 1].siguiente;
+        res = (abajo != NULL) && (u->altura > h);
+      }
+      res = res && ((h < altura) || (cabeza->niveles[h].siguiente == NULL));
+    }
+    nat recorridos = 0;
+    for (nat h = 0; res && (h < altura); h++)
+      for (const Torre *x = cabeza; res && (x != NULL);
+           x = x->niveles[h].siguiente)
+        res = x->niveles[h].resumen.esIgual(
+            resumenTramo(x, h, inicio, recorridos));
+    return res;
+  }
+
+private:
+  Torre *cabeza;
+  nat altura = 0;   // cantidad de niveles con alguna torre
+  uint32_t azar = 2463534242u;
+
+  static nat clave(const Nodo *nodo) { return Clave::clave(nodo->dato); }
+  static nat clave(const Torre *t) { return clave(t->nodo); }
+  static double valor(const Nodo *nodo) { return Valor::valor(nodo->dato); }
+
+  static size_t bytesTorre(nat h) { return sizeof(Torre) + h * sizeof(Nivel); }
+
+  static Torre *crearTorre(Nodo *nodo, nat h) {
+    Torre *res = (Torre *)Asignador::reservar(bytesTorre(h));
+    res->nodo = nodo;
+    res->altura = h;
+    for (nat i = 0; i < h; i++) {
+      res->niveles[i].siguiente = NULL;
+      res->niveles[i].resumen = TResumenSaltos::vacio();
+    }
+    return res;
+  }
+
+  static void liberarTorre(Torre *t) {
+    Asignador::liberar(t, bytesTorre(t->altura));
+  }
+
+  /*
+    Devuelve 0 con probabilidad 3/4 y, si no, h + 1 con probabilidad 1/4 de
+    llegar a cada altura desde la anterior.
+  */
+  nat alturaAlAzar() {
+    // xorshift de 32 bits
+    azar ^= azar << 13;
+    azar ^= azar >> 17;
+    azar ^= azar << 5;
+    uint32_t r = azar;
+    nat h = 0;
+    while ((h < MAX_ALTURA_SALTOS) && ((r & 3) == 0)) {
+      h++;
+      r >>= 2;
+    }
+    return h;
+  }
+
+  /*
+    Devuelve la última torre cuya clave es menor a 'c' (o menor o igual si
+    'iguales'), o la cabeza si no hay. Si 'previas' no es NULL deja en
+    'previas[h]' la última de esas torres en el nivel 'h', para cada nivel
+    menor a 'altura'.
+  */
+  Torre *buscar(nat c, bool iguales, Torre **previas, nat &recorridos) const {
+    Torre *x = cabeza;
+    for (nat h = altura; h-- > 0;) {
+      while ((x->niveles[h].siguiente != NULL) &&
+             ((clave(x->niveles[h].siguiente) < c) ||
+              (iguales && (clave(x->niveles[h].siguiente) == c)))) {
+        x = x->niveles[h].siguiente;
+        recorridos++;
+      }
+      if (previas != NULL)
+        previas[h] = x;
+    }
+    return x;
+  }
+
+  /*
+    Deja en 'u.previas[h]' la última torre del nivel 'h' cuyo nodo precede a
+    'nodo' en la cadena que empieza en 'inicio', o la cabeza si no hay.
+    Entre las torres de igual clave que 'nodo' la posición se determina
+    recorriendo los nodos.
+  */
+  void ubicar(const Nodo *nodo, Nodo *inicio, Ubicacion &u,
+              nat &recorridos) const {
+    buscar(clave(nodo), false, u.previas, recorridos);
+    for (nat h = altura; h < MAX_ALTURA_SALTOS; h++)
+      u.previas[h] = cabeza;
+    Torre *t = u.previas[0]->niveles[0].siguiente;
+    const Nodo *loc = (u.previas[0] == cabeza) ? inicio : u.previas[0]->nodo;
+    while (loc != nodo) {
+      if ((t != NULL) && (loc == t->nodo)) {
+        for (nat i = 0; i < t->altura; i++)
+          u.previas[i] = t;
+        t = t->niveles[0].siguiente;
+      }
+      loc = loc->siguiente;
+      recorridos++;
+    }
+  }
+
+  /*
+    Devuelve el resumen del tramo del nivel 'h' que empieza en 'x'.
+    En el nivel 0 se recorren los nodos del tramo y en los demás se combinan
+    los resúmenes del nivel de abajo.
+  */
+  TResumenSaltos resumenTramo(const Torre *x, nat h, const Nodo *inicio,
+                              nat &recorridos) const {
+    TResumenSaltos res = TResumenSaltos::vacio();
+    const Torre *fin = x->niveles[h].siguiente;
+    if (h == 0) {
+      const Nodo *hasta = (fin == NULL) ? NULL : fin->nodo;
+      for (const Nodo *loc = (x == cabeza) ? inicio : x->nodo; loc != hasta;
+           loc = loc->siguiente) {
+        res.agregar(valor(loc));
+        recorridos++;
+      }
+    } else {
+      for (const Torre *y = x; y != fin; y = y->niveles[h - 1].siguiente) {
+        res.combinar(y->niveles[h - 1].resumen);
+        recorridos++;
+      }
+    }
+    return res;
+  }
+
+  /*
+    Actualiza, de abajo hacia arriba, los resúmenes de las torres de 'u' y de
+    'nueva', si no es NULL.
+  */
+  void recalcular(const Ubicacion &u, Torre *nueva, Nodo *inicio,
+                  nat &recorridos) {
+    for (nat h = 0; h < altura; h++) {
+      if ((nueva != NULL) && (h < nueva->altura))
+        nueva->niveles[h].resumen = resumenTramo(nueva, h, inicio, recorridos);
+      u.previas[h]->niveles[h].resumen =
+          resumenTramo(u.previas[h], h, inicio, recorridos);
+    }
+  }
+
+  Nodo *cota(nat c, bool iguales, Nodo *inicio, nat &recorridos) const {
+    Torre *x = buscar(c, iguales, NULL, recorridos);
+    Nodo *loc = (x == cabeza) ? inicio : x->nodo;
+    while ((loc != NULL) &&
+           ((clave(loc) < c) || (iguales && (clave(loc) == c)))) {
+      loc = loc->siguiente;
+      recorridos++;
+    }
+    return loc;
+  }
+};
+
+#endif
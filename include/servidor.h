@@ -0,0 +1,41 @@
+/*
+  Módulo de definición de 'servidor'.
+
+  Se atienden clientes que envían comandos del intérprete (ver 'interprete')
+  a través de un socket de dominio Unix. Cada conexión tiene su propia
+  'TSesion', que se conserva mientras la conexión esté abierta.
+
+  Los clientes envían un comando por línea y reciben lo mismo que se imprime
+  en el modo '--lote' de 'principal', salvo que los comandos se verifican
+  como se describe en 'crearSesionRemota'. La conexión se cierra cuando el
+  cliente la cierra o ejecuta el comando 'Fin'.
+
+  Los eventos de los sockets se esperan con 'epoll' en un único hilo y las
+  conexiones listas se atienden en un conjunto de hilos trabajadores; una
+  misma conexión nunca es atendida por dos trabajadores a la vez.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#ifndef _SERVIDOR_H
+#define _SERVIDOR_H
+
+#include "epocas.h"
+#include "utils.h"
+
+// Cantidad máxima de trabajadores; cada uno ocupa una ranura de lector de
+// 'epocas' y se deja una para el hilo que los crea.
+#define MAX_HILOS (MAX_LECTORES - 1)
+
+/*
+  Escucha en el socket 'ruta' (que se crea, reemplazando el archivo que
+  hubiera) y atiende clientes con 'hilos' trabajadores hasta recibir SIGINT o
+  SIGTERM. Al terminar cierra las conexiones, libera sus sesiones y borra el
+  socket.
+  Devuelve 0 si terminó normalmente y 1 si no se pudo poner a escuchar.
+  Precondición: 0 < hilos <= MAX_HILOS.
+*/
+int ejecutarServidor(const char *ruta, nat hilos);
+
+#endif
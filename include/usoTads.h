@@ -41,6 +41,8 @@ bool estaOrdenadaPorNaturales(TCadena cad);
 /*
   Devuelve 'true' si y solo si los componentes naturales de algún par de 
   elementos de 'cad' son iguales.  
+  El tiempo de ejecución en el peor caso es O(n^2), siendo 'n' la cantidad de
+  elementos de 'cad'.
 */
 bool hayNatsRepetidos(TCadena cad);
 
@@ -66,7 +68,8 @@ TCadena concatenar(TCadena c1, TCadena c2);
   Se ordena 'cad' de manera creciente según los componentes naturales de sus
   elementos.
   Devuelve 'cad'
-  Precondición: ! hayNatsRepetidos(cad)
+  Precondición: ! hayNatsRepetidos(cad), que se puede establecer en O(n) con
+  'eliminarRepetidos'.
   No se debe obtener ni devolver memoria de manera dinámica.
   Se debe mantener las relaciones de precedencia entre localizadores.
   Si esVaciaCadena(cad) no hace nada.
@@ -93,9 +96,48 @@ TCadena cambiarTodos(nat original, nat nuevo, TCadena cad);
   Precondición: estaOrdenadaPorNaturales (cad), 'menor' <= 'mayor',
   pertenece (menor, cad), pertenece (mayor, cad).
   La 'TCadena' resultado no comparte memoria con 'cad'.
-  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
-  elementos de 'cad'.
+  El tiempo de ejecución es O(log n + k) en promedio si estaIndexada(cad), y
+  si no O(n) en el peor caso, siendo 'n' la cantidad de elementos de 'cad' y
+  'k' la cantidad de elementos del resultado.
 */
 TCadena subCadena(nat menor, nat mayor, TCadena cad);
 
+/*
+  Devuelve la unión de 'c1' y 'c2' según los componentes naturales: los
+  elementos de 'c1' y los de 'c2' cuyo componente natural no es el de ningún
+  elemento de 'c1', ordenados de manera no decreciente según los componentes
+  naturales. Los de 'c1' quedan antes que los de 'c2' con igual componente.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente.
+*/
+TCadena unionCadenas(TCadena c1, TCadena c2);
+
+/*
+  Devuelve la intersección de 'c1' y 'c2' según los componentes naturales:
+  los elementos de 'c1' cuyo componente natural es el de algún elemento de
+  'c2', en el mismo orden.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente. Si las dos cadenas
+  están indexadas los tramos que se saltean se ubican con el índice, y si
+  una es mucho más corta es O(m log n) en promedio, siendo 'm' y 'n' la
+  cantidad de elementos de la más corta y de la más larga.
+*/
+TCadena interseccionCadenas(TCadena c1, TCadena c2);
+
+/*
+  Devuelve la diferencia de 'c1' y 'c2' según los componentes naturales: los
+  elementos de 'c1' cuyo componente natural no es el de ningún elemento de
+  'c2', en el mismo orden.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente. Si estaIndexada(c2)
+  es O(n1 log n2) en promedio.
+*/
+TCadena diferenciaCadenas(TCadena c1, TCadena c2);
+
 #endif
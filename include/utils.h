@@ -22,6 +22,20 @@ typedef unsigned int nat;
 typedef nat *ArregloNats;       // arreglo de nat
 typedef char *ArregloChars;     // arreglo de char
 
+/*
+  La entrada estándar se lee a través de un tampón propio, por lo que no se
+  deben mezclar estas funciones con las de lectura de 'stdio' (scanf, fgets,
+  etc.).
+  Cada hilo puede leer de otro origen fijándolo con 'fijarLectorActual'; en ese
+  caso todas las funciones de lectura de este módulo leen de ese origen.
+*/
+
+// Representación de 'TLector'.
+// Se define en utils.cpp.
+// struct repLector;
+// Declaración del tipo 'TLector'
+typedef struct repLector *TLector;
+
 // leen desde la entrada estándar y devuelven el elemento leído
 nat leerNat();
 char leerChar();
@@ -32,10 +46,68 @@ double leerDouble();
 */
 void leerChars(ArregloChars cs);
 
+/*
+  Como 'leerChars', pero guarda a lo sumo 'tope' - 1 caracteres en 'cs' y
+  descarta el resto de la palabra.
+  Precondición: tope > 0.
+*/
+void leerCharsAcotado(ArregloChars cs, nat tope);
+
 /*
   Lee en 'cs' el resto de la línea de la entrada estandar sin consumir
   el cambi de línea.
 */
 void leerRestoLinea(ArregloChars cs);
 
+/*
+  Como 'leerRestoLinea', pero guarda a lo sumo 'tope' - 1 caracteres en 'cs'
+  y descarta el resto de la línea (sin consumir el cambio de línea).
+  Precondición: tope > 0.
+*/
+void leerRestoLineaAcotado(ArregloChars cs, nat tope);
+
+/*
+  Descarta el resto de la línea de la entrada estándar, incluido el cambio de
+  línea.
+*/
+void descartarRestoLinea();
+
+/*
+  Indica que la entrada estándar es un guion que se lee de corrido: ya no se
+  vacía 'stdout' cada vez que se espera por más entrada.
+*/
+void prepararEntradaEnLote();
+
+/*
+  Devuelve 'true' si y solo si en la entrada estándar solo quedan blancos.
+  Consume esos blancos y, si hace falta, espera a que llegue más entrada.
+*/
+bool finEntrada();
+
+/*
+  Lee desde la entrada estándar un par con la forma (n,r), donde 'n' es un
+  natural y 'r' un real, pudiendo haber blancos entre sus partes.
+  Devuelve 'true' si y solo si el par está bien formado, y en ese caso deja
+  sus componentes en 'natural' y 'real'.
+*/
+bool leerParNatReal(nat *natural, double *real);
+
+/*
+  Devuelve un 'TLector' que lee los 'largo' caracteres de 'datos'. Al
+  agotarlos se comporta como la entrada estándar al llegar al final.
+  El lector comparte memoria con 'datos', que no debe cambiar mientras se use.
+*/
+TLector crearLectorMemoria(const char *datos, nat largo);
+
+/*
+  Libera la memoria asignada a 'lector' (no la de sus datos).
+*/
+void liberarLector(TLector lector);
+
+/*
+  Hace que las funciones de lectura invocadas desde el hilo actual lean de
+  'lector'. Con NULL se vuelve a leer de la entrada estándar.
+*/
+void fijarLectorActual(TLector lector);
+
 #endif
@@ -1,30 +1,476 @@
 #include "../include/cadena.h"
+#include "../include/cadenaT.h"
+#include "../include/saltosT.h"
 #include "../include/utils.h"
 #include "../include/info.h"
+#include "../include/infoInterna.h"
+#include "../include/epocas.h"
+#include "../include/estadisticas.h"
+#include "../include/memoria.h"
+#include "../include/salida.h"
 
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h> // STDOUT_FILENO
 
-struct nodo
+#include <unordered_set>
+#include <vector>
+
+// Cantidad de caracteres a partir de la cual 'imprimirCadenaEn' vuelca lo
+// formateado.
+#define TAM_VOLCADO (1 << 16)
+
+// Cantidad de nodos que 'mezclar' y las operaciones de conjuntos recorren en
+// una cadena en modo ordenado antes de ubicar el siguiente tramo con el índice.
+#define GALOPE 8
+
+/*
+  Política de 'TCadenaT' para 'TCadena': los nodos se obtienen con 'new' y se
+  registran en 'memoria' con el lugar de quien los pide. La clave de cada
+  elemento es su componente natural.
+*/
+struct politicaInfo
+{
+  typedef nodo Nodo;
+  static const bool CONTAR = false;
+
+  struct Clave
+  {
+    static nat clave(TInfo info) { return natInfoEnLinea(info); }
+  };
+
+  // valor que resume el índice
+  struct Valor
+  {
+    static double valor(TInfo info) { return realInfoEnLinea(info); }
+  };
+
+  static nodo *crearNodo(TLugar lugar);
+  static void liberarNodo(nodo *loc, TLugar lugar = TLugar::actual());
+};
+
+// Memoria de las torres de los índices, registrada en 'memoria'.
+struct asignadorIndice
+{
+  static void *reservar(size_t bytes);
+  static void liberar(void *p, size_t bytes);
+};
+
+struct nodo : TEnlacesT<TInfo, nodo>
 {
-  TInfo dato;
-  TLocalizador anterior;
-  TLocalizador siguiente;
 };
 
-struct repCadena
+typedef TListaSaltosT<nodo, politicaInfo::Clave, politicaInfo::Valor,
+                      asignadorIndice>
+    TIndice;
+
+/*
+  'indice' no es NULL si y solo si la cadena está en modo ordenado: sus
+  elementos están ordenados por sus componentes naturales y el índice, con
+  los resúmenes de los componentes reales, se mantiene en cada modificación.
+  Si 'invertida' el primer elemento es el de 'final' y cada elemento sigue
+  al de su 'siguiente'. Una cadena invertida no está en modo ordenado.
+*/
+struct repCadena : TCadenaT<TInfo, politicaInfo>
+{
+  TIndice *indice = NULL;
+  bool invertida = false;
+};
+
+nodo *politicaInfo::crearNodo(TLugar lugar)
+{
+  contarBytes(sizeof(nodo));
+  nodo *res = new nodo;
+  registrarReserva(res, sizeof(nodo), memNodo, lugar);
+  return res;
+}
+
+void politicaInfo::liberarNodo(nodo *loc, TLugar lugar)
+{
+  if (registrarLiberacion(loc, memNodo, lugar))
+  {
+    delete loc;
+    contarBytes(-(long)sizeof(nodo));
+  }
+}
+
+void *asignadorIndice::reservar(size_t bytes)
+{
+  void *res = new char[bytes];
+  registrarReserva(res, bytes, memIndice, TLugar::actual());
+  contarBytes(bytes);
+  return res;
+}
+
+void asignadorIndice::liberar(void *p, size_t bytes)
+{
+  if (registrarLiberacion(p, memIndice, TLugar::actual()))
+  {
+    contarBytes(-(long)bytes);
+    delete[] (char *)p;
+  }
+}
+
+/*
+  Saca a 'cad' del modo ordenado, liberando su índice.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+static void desindexar(TCadena cad)
+{
+  if (cad->indice != NULL)
+  {
+    delete cad->indice;
+    contarBytes(-(long)sizeof(TIndice));
+    cad->indice = NULL;
+  }
+}
+
+/*
+  Primer y último nodo de 'cad', y nodos que siguen y preceden a 'loc' en
+  'cad', según el sentido de 'cad'.
+*/
+static TLocalizador primerNodo(TCadena cad)
+{
+  return cad->invertida ? cad->final : cad->inicio;
+}
+
+static TLocalizador ultimoNodo(TCadena cad)
+{
+  return cad->invertida ? cad->inicio : cad->final;
+}
+
+static TLocalizador nodoSiguiente(TLocalizador loc, TCadena cad)
+{
+  return cad->invertida ? loc->anterior : loc->siguiente;
+}
+
+static TLocalizador nodoAnterior(TLocalizador loc, TCadena cad)
+{
+  return cad->invertida ? loc->siguiente : loc->anterior;
+}
+
+/*
+  Devuelve 'true' si y solo si la clave de 'loc' no es menor que la de su
+  anterior ni mayor que la de su siguiente en 'cad'.
+*/
+static bool mantieneOrden(TLocalizador loc)
+{
+  nat c = natInfoEnLinea(loc->dato);
+  return ((loc->anterior == NULL) ||
+          (natInfoEnLinea(loc->anterior->dato) <= c)) &&
+         ((loc->siguiente == NULL) ||
+          (c <= natInfoEnLinea(loc->siguiente->dato)));
+}
+
+#ifndef NDEBUG
+/*
+  Devuelve 'true' si y solo si 'cad' no está en modo ordenado o su índice es
+  consistente. Se usa para verificar el índice con 'assert'.
+*/
+static bool indiceConsistente(TCadena cad)
+{
+  return (cad->indice == NULL) || cad->indice->esConsistente(cad->inicio);
+}
+#endif
+
+/*
+  Agrega al índice de 'cad', si está en modo ordenado, el nodo 'loc' que se
+  acaba de enlazar o cuyo elemento cambió (sin torre). Si con 'loc' se pierde
+  el orden 'cad' sale del modo ordenado.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n) en promedio.
+*/
+static void indexarNuevo(TLocalizador loc, TCadena cad, TOperacion op)
+{
+  if (cad->indice != NULL)
+  {
+    if (!mantieneOrden(loc))
+    {
+      desindexar(cad);
+    }
+    else
+    {
+      nat recorridos = 0;
+      cad->indice->agregar(loc, cad->inicio, recorridos);
+      contarNodos(op, recorridos);
+    }
+  }
+}
+
+/*
+  Quita del índice de 'cad', si está en modo ordenado, las torres de los
+  nodos que van desde 'desde' hasta 'hasta', incluidos, y deja en 'u' lo que
+  necesita 'recalcularIndice'.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n + k) en promedio, siendo 'k' la cantidad
+  de nodos quitados.
+*/
+static void desindexarNodos(TLocalizador desde, TLocalizador hasta,
+                            TCadena cad, TIndice::Ubicacion &u, TOperacion op)
+{
+  if (cad->indice != NULL)
+  {
+    nat recorridos = 0;
+    cad->indice->quitar(desde, hasta, cad->inicio, u, recorridos);
+    contarNodos(op, recorridos);
+  }
+}
+
+/*
+  Actualiza los resúmenes del índice de 'cad', si está en modo ordenado,
+  después de desenlazar los nodos quitados con 'desindexarNodos'.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n) en promedio.
+*/
+static void recalcularIndice(const TIndice::Ubicacion &u, TCadena cad,
+                             TOperacion op)
+{
+  if (cad->indice != NULL)
+  {
+    nat recorridos = 0;
+    cad->indice->recalcular(u, cad->inicio, recorridos);
+    contarNodos(op, recorridos);
+  }
+}
+
+/*
+  Devuelve el primer nodo de 'cad' cuya clave es mayor o igual a 'clave' (o
+  mayor si 'estricta'), o NULL si no hay. Usa el índice si 'cad' está en modo
+  ordenado y si no recorre desde el inicio.
+  Precondición: los elementos de 'cad' están ordenados por sus claves.
+  El tiempo de ejecución es O(log n) en promedio en modo ordenado, y si no
+  O(n) en el peor caso.
+*/
+static TLocalizador cota(nat clave, bool estricta, TCadena cad, TOperacion op)
+{
+  nat recorridos = 0;
+  TLocalizador res;
+  if (cad->indice == NULL)
+  {
+    res = cad->inicio;
+    while ((res != NULL) &&
+           ((natInfoEnLinea(res->dato) < clave) ||
+            (estricta && (natInfoEnLinea(res->dato) == clave))))
+    {
+      res = res->siguiente;
+      recorridos++;
+    }
+  }
+  else if (estricta)
+  {
+    res = cad->indice->cotaSuperior(clave, cad->inicio, recorridos);
+  }
+  else
+  {
+    res = cad->indice->cotaInferior(clave, cad->inicio, recorridos);
+  }
+  contarNodos(op, recorridos);
+  return res;
+}
+
+/*
+  Devuelve 'true' si y solo si la clave de 'loc' es menor que 'clave' (o
+  igual, si 'estricta').
+*/
+static bool vaAntes(TLocalizador loc, nat clave, bool estricta)
+{
+  nat c = natInfoEnLinea(loc->dato);
+  return (c < clave) || (estricta && (c == clave));
+}
+
+/*
+  Devuelve el primer nodo de 'cad', desde 'loc' (inclusive), cuya clave es
+  mayor o igual a 'clave' (o mayor si 'estricta'), o NULL si no hay. Avanza
+  hasta 8 nodos y, si no alcanza, usa el índice si 'cad' está en modo
+  ordenado y si no sigue recorriendo.
+  Precondición: los elementos de 'cad' están ordenados por sus claves y 'loc'
+  es NULL o un nodo de 'cad'.
+  El tiempo de ejecución es O(min(d, log n)) en promedio en modo ordenado, y
+  si no O(d) en el peor caso, siendo 'd' la cantidad de nodos salteados.
+*/
+static TLocalizador galopar(nat clave, bool estricta, TLocalizador loc,
+                            TCadena cad, nat &recorridos)
+{
+  nat pasos = 0;
+  while ((loc != NULL) && vaAntes(loc, clave, estricta) && (pasos < GALOPE))
+  {
+    loc = loc->siguiente;
+    pasos++;
+  }
+  if ((loc != NULL) && vaAntes(loc, clave, estricta))
+  {
+    if (cad->indice == NULL)
+    {
+      while ((loc != NULL) && vaAntes(loc, clave, estricta))
+      {
+        loc = loc->siguiente;
+        pasos++;
+      }
+    }
+    else if (estricta)
+    {
+      loc = cad->indice->cotaSuperior(clave, cad->inicio, recorridos);
+    }
+    else
+    {
+      loc = cad->indice->cotaInferior(clave, cad->inicio, recorridos);
+    }
+  }
+  recorridos += pasos;
+  return loc;
+}
+
+#ifndef NDEBUG
+/*
+  Devuelve 'true' si y solo si los elementos de 'cad' están ordenados por sus
+  claves. Se usa para verificar precondiciones con 'assert'.
+*/
+static bool estaOrdenada(TCadena cad)
+{
+  bool res = true;
+  for (TLocalizador loc = cad->inicio; res && (loc != NULL);
+       loc = loc->siguiente)
+  {
+    res = mantieneOrden(loc);
+  }
+  return res;
+}
+#endif
+
+/*
+  Libera los nodos que van desde 'elem' hasta 'contexto', incluidos, y los
+  elementos a los que se accede con ellos.
+  Se usa como 'TLiberador' de los segmentos retirados.
+*/
+static void liberarNodos(void *elem, void *contexto)
+{
+  TLocalizador loc = (TLocalizador)elem;
+  TLocalizador hasta = (TLocalizador)contexto;
+  bool fin = false;
+  while (!fin)
+  {
+    TLocalizador a_borrar = loc;
+    fin = (loc == hasta);
+    loc = loc->siguiente;
+    liberarInfo(a_borrar->dato);
+    politicaInfo::liberarNodo(a_borrar);
+  }
+}
+
+/*
+  Libera el cabezal 'elem' junto con todos sus nodos.
+  Se usa como 'TLiberador' de las cadenas retiradas.
+*/
+static void liberarRepCadena(void *elem, void *contexto)
+{
+  TCadena cad = (TCadena)elem;
+  TLocalizador loc = cad->inicio;
+  while (loc != NULL)
+  {
+    TLocalizador a_borrar = loc;
+    loc = loc->siguiente;
+    liberarInfo(a_borrar->dato);
+    politicaInfo::liberarNodo(a_borrar);
+  }
+  desindexar(cad);
+  delete cad;
+  contarBytes(-(long)sizeof(repCadena));
+}
+
+/*
+  Desenlaza de 'cad' los nodos que van desde 'desde' hasta 'hasta', incluidos,
+  manteniendo su índice, y los retira junto con sus elementos.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n + k) en promedio en modo ordenado, y si no
+  O(1) en el peor caso, siendo 'k' la cantidad de nodos retirados.
+*/
+static void quitarSegmento(TLocalizador desde, TLocalizador hasta,
+                           TCadena cad, TOperacion op)
+{
+  TIndice::Ubicacion u;
+  desindexarNodos(desde, hasta, cad, u, op);
+  // el segmento se retira entero, sin cortar sus enlaces
+  cad->desenlazarSegmento(desde, hasta);
+  recalcularIndice(u, cad, op);
+  retirar(desde, hasta, liberarNodos);
+}
+
+/*
+  Nodos desenlazados de una cadena, encadenados con 'siguiente' para
+  retirarlos juntos. Como cambia los enlaces de los nodos quitados, las
+  operaciones que lo usan no se pueden ejecutar mientras otro hilo recorre la
+  cadena.
+*/
+struct nodosQuitados
 {
-  TLocalizador inicio;
-  TLocalizador final;
+  TLocalizador primero = NULL;
+  TLocalizador ultimo = NULL;
+
+  // Desenlaza 'loc' de 'cad' y lo agrega al final.
+  void quitar(TLocalizador loc, TCadena cad)
+  {
+    cad->desenlazar(loc);
+    if (primero == NULL)
+    {
+      primero = loc;
+    }
+    else
+    {
+      ultimo->siguiente = loc;
+    }
+    ultimo = loc;
+  }
+
+  // Retira los nodos agregados junto con sus elementos.
+  void retirarTodos()
+  {
+    if (primero != NULL)
+    {
+      retirar(primero, ultimo, liberarNodos);
+    }
+  }
 };
 
+/*
+  Pasa al final de 'destino' los nodos de 'origen' que van desde 'desde'
+  hasta 'hasta', incluidos, manteniendo el índice de 'origen'.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n + k) en promedio en modo ordenado, y si no
+  O(k) en el peor caso, siendo 'k' la cantidad de nodos pasados.
+*/
+static void pasarSegmentoAlFinal(TLocalizador desde, TLocalizador hasta,
+                                 TCadena origen, TCadena destino,
+                                 TOperacion op)
+{
+  TIndice::Ubicacion u;
+  desindexarNodos(desde, hasta, origen, u, op);
+  origen->desenlazarSegmento(desde, hasta);
+  recalcularIndice(u, origen, op);
+  nat recorridos = 0;
+  bool fin = false;
+  while (!fin)
+  {
+    TLocalizador loc = desde;
+    fin = (loc == hasta);
+    desde = loc->siguiente;
+    destino->enlazarAlFinal(loc);
+    recorridos++;
+  }
+  contarNodos(op, recorridos);
+}
+
 /*
   Devuelve 'true' si y solo si 'loc' es un 'TLocalizador' válido.
   En cadenas enlazadas un 'TLocalizador' es válido si y solo si no es 'NULL'.
   El tiempo de ejecución en el peor caso es O(1).
 */
-bool esLocalizador(TLocalizador loc) { return loc != NULL; }
+bool esLocalizador(TLocalizador loc)
+{
+  contarLlamada(opEsLocalizador);
+  return loc != NULL;
+}
 
 /*
   Devuelve la 'TCadena' vacía (sin elementos).
@@ -32,6 +478,8 @@ bool esLocalizador(TLocalizador loc) { return loc != NULL; }
 */
 TCadena crearCadena()
 {
+  contarLlamada(opCrearCadena);
+  contarBytes(sizeof(repCadena));
   TCadena res = new repCadena;
   res->inicio = res->final = NULL;
   return res;
@@ -44,15 +492,8 @@ TCadena crearCadena()
 */
 void liberarCadena(TCadena cad)
 {
-  TLocalizador a_borrar;
-  while (cad->inicio != NULL)
-  {
-    a_borrar = cad->inicio;
-    cad->inicio = cad->inicio->siguiente;
-    liberarInfo(a_borrar->dato);
-    delete a_borrar;
-  }
-  delete cad;
+  contarLlamada(opLiberarCadena);
+  retirar(cad, NULL, liberarRepCadena);
 }
 
 /*
@@ -61,6 +502,7 @@ void liberarCadena(TCadena cad)
 */
 bool esVaciaCadena(TCadena cad)
 {
+  contarLlamada(opEsVaciaCadena);
   assert(((cad->inicio == NULL) && (cad->final == NULL)) ||
          ((cad->inicio != NULL) && (cad->final != NULL)));
   return ((cad->inicio == NULL) && (cad->final == NULL));
@@ -73,16 +515,10 @@ bool esVaciaCadena(TCadena cad)
 */
 TLocalizador inicioCadena(TCadena cad)
 {
-  TLocalizador res;
-  if (esVaciaCadena(cad))
-  {
-    res = NULL;
-  }
-  else
-  {
-    res = cad->inicio;
-  }
-  return res;
+  contarLlamada(opInicioCadena);
+  // sin 'esVaciaCadena', que verifica 'inicio' y 'final' juntos y puede
+  // fallar si otro hilo los está modificando
+  return primerNodo(cad);
 }
 
 /*
@@ -92,6 +528,7 @@ TLocalizador inicioCadena(TCadena cad)
 */
 TLocalizador finalCadena(TCadena cad)
 {
+  contarLlamada(opFinalCadena);
   TLocalizador res;
   if (esVaciaCadena(cad))
   {
@@ -99,7 +536,7 @@ TLocalizador finalCadena(TCadena cad)
   }
   else
   {
-    res = cad->final;
+    res = ultimoNodo(cad);
   }
   return res;
 }
@@ -111,6 +548,7 @@ TLocalizador finalCadena(TCadena cad)
 */
 TInfo infoCadena(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opInfoCadena);
   return loc->dato;
 }
 
@@ -123,6 +561,7 @@ TInfo infoCadena(TLocalizador loc, TCadena cad)
 */
 TLocalizador siguiente(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opSiguiente);
   assert(localizadorEnCadena(loc, cad));
   TLocalizador res;
   if (esFinalCadena(loc, cad))
@@ -131,11 +570,26 @@ TLocalizador siguiente(TLocalizador loc, TCadena cad)
   }
   else
   {
-    res = loc->siguiente;
+    res = nodoSiguiente(loc, cad);
   }
   return res;
 }
 
+/*
+  Como 'siguiente', pero sin verificar la precondición: es O(1) también
+  cuando se compila con 'assert', mientras que 'siguiente' verifica con
+  'localizadorEnCadena', que es O(n). Se usa para recorrer una cadena entera.
+  'loc' puede ser también un nodo que otro hilo quitó de 'cad' durante el
+  recorrido (ver el comienzo de este archivo).
+  Precondición: localizadorEnCadena(loc, cad).
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+TLocalizador siguienteSinVerificar(TLocalizador loc, TCadena cad)
+{
+  contarLlamada(opSiguiente);
+  return nodoSiguiente(loc, cad);
+}
+
 /*
   Devuelve el 'TLocalizador' con el que se accede al elemento de 'cad'
   inmediatamente anterior a 'loc'.
@@ -145,6 +599,7 @@ TLocalizador siguiente(TLocalizador loc, TCadena cad)
 */
 TLocalizador anterior(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opAnterior);
   TLocalizador res;
   if (esInicioCadena(loc, cad))
   {
@@ -152,7 +607,7 @@ TLocalizador anterior(TLocalizador loc, TCadena cad)
   }
   else
   {
-    res = loc->anterior;
+    res = nodoAnterior(loc, cad);
   }
   return res;
 }
@@ -164,6 +619,7 @@ TLocalizador anterior(TLocalizador loc, TCadena cad)
 */
 bool esFinalCadena(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opEsFinalCadena);
   bool aux;
   if (esVaciaCadena(cad))
   {
@@ -171,7 +627,7 @@ bool esFinalCadena(TLocalizador loc, TCadena cad)
   }
   else
   {
-    aux = (loc == cad->final);
+    aux = (loc == ultimoNodo(cad));
   }
   return aux;
 }
@@ -183,6 +639,7 @@ bool esFinalCadena(TLocalizador loc, TCadena cad)
 */
 bool esInicioCadena(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opEsInicioCadena);
   bool aux;
   if (esVaciaCadena(cad))
   {
@@ -190,7 +647,7 @@ bool esInicioCadena(TLocalizador loc, TCadena cad)
   }
   else
   {
-    aux = (loc == cad->inicio);
+    aux = (loc == primerNodo(cad));
   }
   return aux;
 }
@@ -218,24 +675,19 @@ bool esInicioCadena(TLocalizador loc, TCadena cad)
   return cad;
 }
 */
-TCadena insertarAlFinal(TInfo i, TCadena cad)
+TCadena insertarAlFinal(TInfo i, TCadena cad, TLugar lugar)
 {
-  TLocalizador aux = new nodo;
-  aux->dato = i;
-  aux->siguiente = NULL;
-  if (esVaciaCadena(cad))
+  contarLlamada(opInsertarAlFinal);
+  if (cad->invertida && !cad->esVacia())
   {
-    aux->anterior = NULL;
-    cad->inicio = cad->final = aux;
+    cad->insertarAntes(i, cad->inicio, lugar);
   }
   else
   {
-    aux->anterior = cad->final;
-    cad->final->siguiente = aux;
-    cad->final = aux;
+    cad->insertarAlFinal(i, lugar);
   }
-  aux = NULL;
-  delete aux;
+  indexarNuevo(ultimoNodo(cad), cad, opInsertarAlFinal);
+  assert(indiceConsistente(cad));
   return cad;
 }
 /*
@@ -244,26 +696,23 @@ TCadena insertarAlFinal(TInfo i, TCadena cad)
   Precondición: localizadorEnCadena(loc, cad).
   El tiempo de ejecución en el peor caso es O(1).
 */
-TCadena insertarAntes(TInfo i, TLocalizador loc, TCadena cad)
+TCadena insertarAntes(TInfo i, TLocalizador loc, TCadena cad, TLugar lugar)
 {
-  TLocalizador res = new nodo;
-  res->dato = i;
-  if (esInicioCadena(loc, cad))
+  contarLlamada(opInsertarAntes);
+  if (!cad->invertida)
   {
-    res->anterior = NULL;
-    res->siguiente = loc;
-    cad->inicio = res;
-    loc->anterior = res;
+    cad->insertarAntes(i, loc, lugar);
   }
-  else 
+  else if (loc->siguiente == NULL)
   {
-    loc->anterior->siguiente = res;
-    res->anterior = loc->anterior;
-    res->siguiente = loc;
-    loc->anterior = res;
+    cad->insertarAlFinal(i, lugar);
   }
-  res = NULL;
-  delete res;
+  else
+  {
+    cad->insertarAntes(i, loc->siguiente, lugar);
+  }
+  indexarNuevo(nodoAnterior(loc, cad), cad, opInsertarAntes);
+  assert(indiceConsistente(cad));
   return cad;
 }
 
@@ -277,40 +726,18 @@ TCadena insertarAntes(TInfo i, TLocalizador loc, TCadena cad)
 */
 TCadena removerDeCadena(TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opRemoverDeCadena);
   if (loc != NULL)
   {
-    if (loc == cad->inicio)
-    {
-      if (loc == cad->final)
-      {
-        cad->final = cad->inicio = NULL;
-        liberarInfo(loc->dato);
-      }
-      else
-      {
-        loc->siguiente->anterior = NULL;
-        cad->inicio = loc->siguiente;
-        loc->siguiente = NULL;
-        liberarInfo(loc->dato);
-      }
-    }
-    else if (loc == cad->final)
-    {
-      loc->anterior->siguiente = NULL;
-      cad->final = loc->anterior;
-      loc->anterior = NULL;
-      liberarInfo(loc->dato);
-    }
-    else
-    {
-      loc->siguiente->anterior = loc->anterior;
-      loc->anterior->siguiente = loc->siguiente;
-      loc->anterior = NULL;
-      loc->siguiente = NULL;
-      liberarInfo(loc->dato);
-    }
+    TIndice::Ubicacion u;
+    desindexarNodos(loc, loc, cad, u, opRemoverDeCadena);
+    // 'loc' conserva sus enlaces para que un lector que esté en él pueda
+    // seguir avanzando hasta que se libere
+    cad->desenlazar(loc);
+    recalcularIndice(u, cad, opRemoverDeCadena);
+    retirar(loc, loc, liberarNodos);
   }
-  delete loc;
+  assert(indiceConsistente(cad));
   return cad;
 }
 
@@ -325,49 +752,110 @@ TCadena removerDeCadena(TLocalizador loc, TCadena cad)
 */
 void imprimirCadena(TCadena cad)
 {
-  TLocalizador res;
-  if (esVaciaCadena(cad))
+  imprimirCadenaEn(STDOUT_FILENO, cad);
+}
+
+// buffer reutilizado por 'imprimirCadenaEn'
+static thread_local TBufferSalida impresion = NULL;
+
+/*
+  Agrega 'info' a 'buf' con la forma (n,r).
+*/
+static void agregarElemento(TInfo info, TBufferSalida buf)
+{
+  agregarCaracter('(', buf);
+  // como con "%i", el natural se muestra con signo
+  agregarEntero((int)natInfoEnLinea(info), buf);
+  agregarCaracter(',', buf);
+  agregarReal2(realInfoEnLinea(info), buf);
+  agregarCaracter(')', buf);
+}
+
+/*
+  Escribe el contenido de 'buf' en 'fd' y lo deja vacío.
+*/
+static void volcar(int fd, TBufferSalida buf)
+{
+  if (fd == STDOUT_FILENO)
   {
-    printf("\n");
+    fwrite(textoBufferSalida(buf), 1, largoBufferSalida(buf), stdout);
+    vaciarBufferSalida(buf);
   }
   else
   {
-    res = cad->inicio;
-    while (res != NULL)
-    {
-      printf("(%i,%.2f)", natInfo(res->dato), realInfo(res->dato));
-      res = res->siguiente;
-    }
-    printf("\n");
+    volcarBufferSalida(fd, buf);
   }
-  res = NULL;
-  delete res;
 }
 
-/*
-  Devuelve el 'TLocalizador' con el que se accede al k-esimo elemento de 'cad'.
-  Si 'k' es 0 o mayor a la cantidad de elementos de 'cad' devuelve un
+void imprimirCadenaEn(int fd, TCadena cad)
+{
+  contarLlamada(opImprimirCadena);
+  if (impresion == NULL)
+  {
+    impresion = crearBufferSalida(2 * TAM_VOLCADO);
+  }
+  nat recorridos = 0;
+  entrarLectura();
+  TLocalizador res = primerNodo(cad);
+  while (res != NULL)
+  {
+    agregarElemento(res->dato, impresion);
+    if (largoBufferSalida(impresion) >= TAM_VOLCADO)
+    {
+      volcar(fd, impresion);
+    }
+    res = nodoSiguiente(res, cad);
+    recorridos++;
+  }
+  salirLectura();
+  contarNodos(opImprimirCadena, recorridos);
+  agregarCaracter('\n', impresion);
+  volcar(fd, impresion);
+}
+
+void imprimirCadenaEnBuffer(TBufferSalida buf, TCadena cad)
+{
+  contarLlamada(opImprimirCadena);
+  nat recorridos = 0;
+  entrarLectura();
+  TLocalizador res = primerNodo(cad);
+  while (res != NULL)
+  {
+    agregarElemento(res->dato, buf);
+    res = nodoSiguiente(res, cad);
+    recorridos++;
+  }
+  salirLectura();
+  contarNodos(opImprimirCadena, recorridos);
+  agregarCaracter('\n', buf);
+}
+
+/*
+  Devuelve el 'TLocalizador' con el que se accede al k-esimo elemento de 'cad'.
+  Si 'k' es 0 o mayor a la cantidad de elementos de 'cad' devuelve un
   localizdor  no válido.
   El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
   elementos en 'cad'.
 */
 TLocalizador kesimo(nat k, TCadena cad)
 {
+  contarLlamada(opKesimo);
+  nat recorridos = 0;
   TLocalizador res;
-  nat i = 1;
-  if (k == 0)
+  if (!cad->invertida)
   {
-    res = NULL;
+    res = cad->kesimo(k, recorridos);
   }
   else
   {
-    res = inicioCadena(cad);
-    while ((res != NULL) && (i < k))
+    res = (k == 0) ? NULL : cad->final;
+    for (nat i = 1; (res != NULL) && (i < k); i++)
     {
-      i++;
-      res = siguiente(res, cad);
+      res = res->anterior;
+      recorridos++;
     }
   }
+  contarNodos(opKesimo, recorridos);
   return res;
 }
 
@@ -380,10 +868,13 @@ TLocalizador kesimo(nat k, TCadena cad)
 */
 bool localizadorEnCadena(TLocalizador loc, TCadena cad)
 {
-  TLocalizador cursor = inicioCadena(cad);
-  while (esLocalizador(cursor) && (cursor != loc))
-    cursor = siguiente(cursor, cad);
-  return esLocalizador(cursor);
+  contarLlamada(opLocalizadorEnCadena);
+  // se avanza por los enlaces y no con 'siguiente', cuya precondición se
+  // verifica con esta misma función
+  nat recorridos = 0;
+  bool res = cad->contiene(loc, recorridos);
+  contarNodos(opLocalizadorEnCadena, recorridos);
+  return res;
 }
 
 /*
@@ -394,14 +885,16 @@ bool localizadorEnCadena(TLocalizador loc, TCadena cad)
 */
 bool precedeEnCadena(TLocalizador loc1, TLocalizador loc2, TCadena cad)
 {
+  contarLlamada(opPrecedeEnCadena);
   bool res;
   res = localizadorEnCadena(loc1, cad);
   if (res)
   {
-    TLocalizador cursor = loc1;
-    while (esLocalizador(cursor) && (cursor != loc2))
-      cursor = siguiente(cursor, cad);
-    res = esLocalizador(cursor);
+    nat recorridos = 0;
+    // en una cadena invertida se avanza desde 'loc2' hacia 'loc1'
+    res = cad->invertida ? repCadena::precedeDesde(loc2, loc1, recorridos)
+                         : repCadena::precedeDesde(loc1, loc2, recorridos);
+    contarNodos(opPrecedeEnCadena, recorridos);
     assert(!res || localizadorEnCadena(loc2, cad));
   }
   return res;
@@ -416,29 +909,39 @@ bool precedeEnCadena(TLocalizador loc1, TLocalizador loc2, TCadena cad)
   El valor de 'sgm' queda indeterminado.
   Si esVaciaCadena(cad) 'loc' es ignorado y el segmento queda insertado.
   Precondición: esVaciaCadena(cad) o localizadorEnCadena(loc, cad).
-  El tiempo de ejecución en el peor caso es O(1).
+  El tiempo de ejecución en el peor caso es O(1) si 'sgm' y 'cad' no están
+  una invertida y la otra no (ver 'invertirCadena'), y si no O(k), siendo 'k'
+  la cantidad de elementos de 'sgm'.
 */
 TCadena insertarSegmentoDespues(TCadena sgm, TLocalizador loc, TCadena cad)
 {
-  if (!esVaciaCadena(sgm)) {
-    if (esVaciaCadena(cad))
-    {
-      cad->inicio = sgm->inicio;
-      cad->final = sgm->final;
-    } else if (esFinalCadena(loc,cad))
-    {
-      loc->siguiente = sgm->inicio;
-      sgm->inicio->anterior = cad->final;
-      cad->final = sgm->final;
-    } else 
-    {
-      loc->siguiente->anterior = sgm->final;
-      sgm->final->siguiente = loc->siguiente;
-      loc->siguiente = sgm->inicio;
-      sgm->inicio->anterior = loc;
-    }
+  contarLlamada(opInsertarSegmentoDespues);
+  if (!esVaciaCadena(sgm))
+  {
+    desindexar(cad);
+  }
+  if (esVaciaCadena(cad))
+  {
+    cad->invertida = sgm->invertida;
+  }
+  else if (sgm->invertida != cad->invertida)
+  {
+    nat recorridos = 0;
+    sgm->invertirEnlaces(recorridos);
+    sgm->invertida = cad->invertida;
+    contarNodos(opInsertarSegmentoDespues, recorridos);
   }
-  sgm->inicio = sgm->final = NULL;
+  // en una cadena invertida 'sgm' va antes de 'loc' en los enlaces
+  TLocalizador antes = loc;
+  if (esVaciaCadena(cad))
+  {
+    antes = NULL;
+  }
+  else if (cad->invertida)
+  {
+    antes = loc->anterior;
+  }
+  cad->enlazarSegmentoDespues(*sgm, antes);
   liberarCadena(sgm);
   return cad;
 }
@@ -454,6 +957,8 @@ TCadena insertarSegmentoDespues(TCadena sgm, TLocalizador loc, TCadena cad)
 */
 TCadena copiarSegmento(TLocalizador desde, TLocalizador hasta, TCadena cad)
 {
+  contarLlamada(opCopiarSegmento);
+  assert(esVaciaCadena(cad) || precedeEnCadena(desde, hasta, cad));
   TCadena x;
   x = crearCadena();
   if (esVaciaCadena(cad))
@@ -462,13 +967,17 @@ TCadena copiarSegmento(TLocalizador desde, TLocalizador hasta, TCadena cad)
   }
   else
   {
-    TInfo aux;
-    while (precedeEnCadena(desde, hasta, cad))
+    // se avanza hasta el nodo que sigue a 'hasta' sin volver a verificar la
+    // precedencia en cada paso, para que el costo sea O(k)
+    TLocalizador fin = nodoSiguiente(hasta, cad);
+    nat recorridos = 0;
+    while (desde != fin)
     {
-      aux = copiaInfo(desde->dato);
-      insertarAlFinal(aux, x);
-      desde = desde->siguiente;
+      insertarAlFinal(copiaInfo(desde->dato), x);
+      desde = nodoSiguiente(desde, cad);
+      recorridos++;
     }
+    contarNodos(opCopiarSegmento, recorridos);
   }
   return x;
 }
@@ -484,13 +993,20 @@ TCadena copiarSegmento(TLocalizador desde, TLocalizador hasta, TCadena cad)
 */
 TCadena borrarSegmento(TLocalizador desde, TLocalizador hasta, TCadena cad)
 {
-  if (!esVaciaCadena(cad)){
-    while (precedeEnCadena(desde, hasta, cad)){
-      TLocalizador aux = desde;
-      desde = siguiente(desde, cad);
-      removerDeCadena(aux, cad);
+  contarLlamada(opBorrarSegmento);
+  if (!esVaciaCadena(cad))
+  {
+    assert(precedeEnCadena(desde, hasta, cad));
+    if (cad->invertida)
+    {
+      quitarSegmento(hasta, desde, cad, opBorrarSegmento);
+    }
+    else
+    {
+      quitarSegmento(desde, hasta, cad, opBorrarSegmento);
     }
   }
+  assert(indiceConsistente(cad));
   return cad;
 }
 
@@ -503,7 +1019,12 @@ TCadena borrarSegmento(TLocalizador desde, TLocalizador hasta, TCadena cad)
 */
 TCadena cambiarEnCadena(TInfo i, TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opCambiarEnCadena);
+  TIndice::Ubicacion u;
+  desindexarNodos(loc, loc, cad, u, opCambiarEnCadena);
   loc->dato = i;
+  indexarNuevo(loc, cad, opCambiarEnCadena);
+  assert(indiceConsistente(cad));
   return cad;
 }
 
@@ -518,10 +1039,28 @@ TCadena cambiarEnCadena(TInfo i, TLocalizador loc, TCadena cad)
 */
 TCadena intercambiar(TLocalizador loc1, TLocalizador loc2, TCadena cad)
 {
+  contarLlamada(opIntercambiar);
+  if ((cad->indice != NULL) && (loc1 != loc2))
+  {
+    TIndice::Ubicacion u;
+    desindexarNodos(loc1, loc1, cad, u, opIntercambiar);
+    desindexarNodos(loc2, loc2, cad, u, opIntercambiar);
+  }
   TInfo aux;
   aux = loc1->dato;
   loc1->dato = loc2->dato;
   loc2->dato = aux;
+  if ((cad->indice != NULL) && (loc1 != loc2))
+  {
+    // el orden se verifica con los dos elementos ya intercambiados
+    if (!mantieneOrden(loc1) || !mantieneOrden(loc2))
+    {
+      desindexar(cad);
+    }
+    indexarNuevo(loc1, cad, opIntercambiar);
+    indexarNuevo(loc2, cad, opIntercambiar);
+  }
+  assert(indiceConsistente(cad));
   return cad;
 }
 
@@ -536,25 +1075,21 @@ TCadena intercambiar(TLocalizador loc1, TLocalizador loc2, TCadena cad)
 */
 TLocalizador siguienteClave(nat clave, TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opSiguienteClave);
+  assert(esVaciaCadena(cad) || localizadorEnCadena(loc, cad));
   TLocalizador res;
-  if (localizadorEnCadena(loc, cad) == false)
+  // la precondición no se verifica con 'localizadorEnCadena', que es O(n)
+  // y haría cuadráticas a las búsquedas repetidas como la de 'cambiarTodos'
+  if (esVaciaCadena(cad) || !esLocalizador(loc))
   {
     res = NULL;
   }
   else
   {
-    while ((loc->siguiente != cad->final->siguiente) && (clave != natInfo(loc->dato)))
-    {
-      loc = loc->siguiente;
-    }
-    if (clave == natInfo(loc->dato))
-    {
-      res = loc;
-    }
-    else
-    {
-      res = NULL;
-    }
+    nat recorridos = 0;
+    res = cad->invertida ? repCadena::buscarAtras(clave, loc, recorridos)
+                         : repCadena::buscarAdelante(clave, loc, recorridos);
+    contarNodos(opSiguienteClave, recorridos);
   }
   return res;
 }
@@ -570,51 +1105,971 @@ TLocalizador siguienteClave(nat clave, TLocalizador loc, TCadena cad)
 */
 TLocalizador anteriorClave(nat clave, TLocalizador loc, TCadena cad)
 {
+  contarLlamada(opAnteriorClave);
+  assert(esVaciaCadena(cad) || localizadorEnCadena(loc, cad));
   TLocalizador res;
-  if (localizadorEnCadena(loc, cad) == false)
+  // la precondición no se verifica con 'localizadorEnCadena', que es O(n)
+  // y haría cuadráticas a las búsquedas repetidas como la de 'cambiarTodos'
+  if (esVaciaCadena(cad) || !esLocalizador(loc))
   {
     res = NULL;
   }
   else
   {
-    while ((loc->anterior != cad->inicio->anterior) && (clave != natInfo(loc->dato)))
+    nat recorridos = 0;
+    res = cad->invertida ? repCadena::buscarAdelante(clave, loc, recorridos)
+                         : repCadena::buscarAtras(clave, loc, recorridos);
+    contarNodos(opAnteriorClave, recorridos);
+  }
+  return res;
+}
+
+/*
+  Devuelve el 'TLocalizador' con el que se accede al elemento cuyo componente
+  natural es el menor en el segmento que va desde 'loc' hasta finalCadena(cad).
+  Si hay más de un elemento cuyo valor es el menor el resultado accede al que
+  precede a los otros.
+  Precondición: localizadorEnCadena(loc, cad).
+  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TLocalizador menorEnCadena(TLocalizador loc, TCadena cad)
+{
+  contarLlamada(opMenorEnCadena);
+  normalizar(cad);
+  nat recorridos = 0;
+  TLocalizador res = repCadena::menor(loc, recorridos);
+  contarNodos(opMenorEnCadena, recorridos);
+  return res;
+}
+
+/*
+  Ordena los elementos de 'cad' de manera creciente según sus componentes
+  naturales, moviendo los elementos entre los nodos. El orden entre elementos
+  con igual componente natural se mantiene.
+  Devuelve 'cad'.
+  Con hasta 16 elementos se usa una red de ordenamiento.
+  El tiempo de ejecución en el peor caso es O(n^2), siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena ordenarCadena(TCadena cad)
+{
+  contarLlamada(opOrdenarCadena);
+  normalizar(cad);
+  nat recorridos = 0;
+  cad->ordenar(recorridos);
+  contarNodos(opOrdenarCadena, recorridos);
+  return cad;
+}
+
+/*
+  Pone a 'cad' en modo ordenado: arma un índice sobre sus nodos que se
+  mantiene en cada modificación mientras los elementos sigan ordenados.
+  Devuelve 'cad'.
+  Precondición: los elementos de 'cad' están ordenados de manera no
+  decreciente según sus componentes naturales.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena indexarCadena(TCadena cad)
+{
+  contarLlamada(opIndexarCadena);
+  normalizar(cad);
+  assert(estaOrdenada(cad));
+  if (cad->indice == NULL)
+  {
+    contarBytes(sizeof(TIndice));
+    cad->indice = new TIndice;
+  }
+  nat recorridos = 0;
+  cad->indice->construir(cad->inicio, recorridos);
+  contarNodos(opIndexarCadena, recorridos);
+  assert(indiceConsistente(cad));
+  return cad;
+}
+
+/*
+  Devuelve 'true' si y solo si 'cad' está en modo ordenado.
+  El tiempo de ejecución en el peor caso es O(1).
+*/
+bool estaIndexada(TCadena cad)
+{
+  contarLlamada(opEstaIndexada);
+  return cad->indice != NULL;
+}
+
+/*
+  Se inserta 'i' en 'cad' después de los elementos cuyo componente natural es
+  menor o igual al de 'i' y antes de los demás.
+  Devuelve 'cad'.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena insertarOrdenado(TInfo i, TCadena cad, TLugar lugar)
+{
+  contarLlamada(opInsertarOrdenado);
+  normalizar(cad);
+  assert(estaOrdenada(cad));
+  TLocalizador loc = cota(natInfoEnLinea(i), true, cad, opInsertarOrdenado);
+  if (loc == NULL)
+  {
+    cad->insertarAlFinal(i, lugar);
+    loc = cad->final;
+  }
+  else
+  {
+    cad->insertarAntes(i, loc, lugar);
+    loc = loc->anterior;
+  }
+  indexarNuevo(loc, cad, opInsertarOrdenado);
+  assert(indiceConsistente(cad));
+  return cad;
+}
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es igual a 'clave'. Si no hay devuelve un
+  'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador buscarClave(nat clave, TCadena cad)
+{
+  contarLlamada(opBuscarClave);
+  normalizar(cad);
+  assert(estaOrdenada(cad));
+  TLocalizador res = cota(clave, false, cad, opBuscarClave);
+  if ((res != NULL) && (natInfoEnLinea(res->dato) != clave))
+  {
+    res = NULL;
+  }
+  return res;
+}
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es mayor o igual a 'clave'. Si no hay
+  devuelve un 'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador cotaInferior(nat clave, TCadena cad)
+{
+  contarLlamada(opCotaInferior);
+  normalizar(cad);
+  assert(estaOrdenada(cad));
+  return cota(clave, false, cad, opCotaInferior);
+}
+
+/*
+  Devuelve el primer 'TLocalizador' con el que se accede a un elemento de
+  'cad' cuyo componente natural es mayor a 'clave'. Si no hay devuelve un
+  'TLocalizador' no válido.
+  Precondición: estaOrdenadaPorNaturales(cad).
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador cotaSuperior(nat clave, TCadena cad)
+{
+  contarLlamada(opCotaSuperior);
+  normalizar(cad);
+  assert(estaOrdenada(cad));
+  return cota(clave, true, cad, opCotaSuperior);
+}
+
+/*
+  Devuelve el primer 'TLocalizador' de 'cad', desde 'loc' (inclusive), con el
+  que se accede a un elemento cuyo componente natural es mayor o igual a
+  'clave', o uno no válido si no hay. Avanza hasta 8 elementos y, si no
+  alcanza, usa el índice si estaIndexada(cad) y si no sigue avanzando.
+  Sirve para recorrer una cadena ordenada salteando tramos, como en las
+  operaciones de conjuntos.
+  Precondición: estaOrdenadaPorNaturales(cad) y 'loc' no es válido o
+  localizadorEnCadena(loc, cad).
+  El tiempo de ejecución es O(min(d, log n)) en promedio si estaIndexada(cad),
+  y si no O(d) en el peor caso, siendo 'd' la cantidad de elementos salteados
+  y 'n' la cantidad de elementos en 'cad'.
+*/
+TLocalizador galoparClave(nat clave, TLocalizador loc, TCadena cad)
+{
+  contarLlamada(opGaloparClave);
+  // sin verificar el orden: se invoca en cada paso de un recorrido
+  normalizar(cad);
+  nat recorridos = 0;
+  loc = galopar(clave, false, loc, cad, recorridos);
+  contarNodos(opGaloparClave, recorridos);
+  return loc;
+}
+
+/*
+  Devuelve el resumen de los componentes reales de los elementos de 'cad'
+  cuyo componente natural está entre 'menor' y 'mayor', incluidos. Usa el
+  índice si 'cad' está en modo ordenado y si no la recorre entera.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(log n) en promedio en modo ordenado, y si no
+  O(n) en el peor caso.
+*/
+static TResumenSaltos resumirRango(nat menor, nat mayor, TCadena cad,
+                                   TOperacion op)
+{
+  nat recorridos = 0;
+  TResumenSaltos res;
+  if (cad->indice != NULL)
+  {
+    res = cad->indice->resumir(menor, mayor, cad->inicio, recorridos);
+  }
+  else
+  {
+    res = TResumenSaltos::vacio();
+    for (TLocalizador loc = cad->inicio; loc != NULL; loc = loc->siguiente)
     {
-      loc = loc->anterior;
+      nat c = natInfoEnLinea(loc->dato);
+      if ((menor <= c) && (c <= mayor))
+      {
+        res.agregar(realInfoEnLinea(loc->dato));
+      }
+      recorridos++;
     }
-    if (clave == natInfo(loc->dato))
+  }
+  contarNodos(op, recorridos);
+  return res;
+}
+
+/*
+  Devuelve la cantidad de elementos de 'cad' cuyo componente natural está
+  entre 'menor' y 'mayor', incluidos.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+nat contarEnRango(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opContarEnRango);
+  return resumirRango(menor, mayor, cad, opContarEnRango).cantidad;
+}
+
+/*
+  Devuelve la suma de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double sumaReales(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opSumaReales);
+  return resumirRango(menor, mayor, cad, opSumaReales).suma;
+}
+
+/*
+  Devuelve el menor de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  Precondición: contarEnRango(menor, mayor, cad) > 0.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double minReal(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opMinReal);
+  TResumenSaltos res = resumirRango(menor, mayor, cad, opMinReal);
+  assert(res.cantidad > 0);
+  return res.minimo;
+}
+
+/*
+  Devuelve el mayor de los componentes reales de los elementos de 'cad' cuyo
+  componente natural está entre 'menor' y 'mayor', incluidos.
+  Precondición: contarEnRango(menor, mayor, cad) > 0.
+  El tiempo de ejecución es O(log n) en promedio si estaIndexada(cad), y si no
+  O(n) en el peor caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+double maxReal(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opMaxReal);
+  TResumenSaltos res = resumirRango(menor, mayor, cad, opMaxReal);
+  assert(res.cantidad > 0);
+  return res.maximo;
+}
+
+/*
+  Intercala los nodos de 'c2' en 'c1' y libera el resto de 'c2', como
+  'mezclar'.
+  Los nodos recorridos se cuentan en 'op'.
+*/
+static void intercalar(TCadena c1, TCadena c2, TOperacion op)
+{
+  normalizar(c1);
+  normalizar(c2);
+  assert(c1 != c2);
+  assert(estaOrdenada(c1) && estaOrdenada(c2));
+  nat recorridos = 0;
+  // los nodos de 'c2' cambian de cadena: su índice ya no sirve
+  desindexar(c2);
+  if (c1->indice == NULL)
+  {
+    c1->mezclar(*c2, recorridos);
+  }
+  else
+  {
+    c1->mezclar(
+        *c2,
+        [c1, &recorridos](nat clave, TLocalizador loc)
+        { return galopar(clave, true, loc, c1, recorridos); },
+        [c1, &recorridos](TLocalizador primero, TLocalizador ultimo)
+        {
+          TLocalizador fin = ultimo->siguiente;
+          for (TLocalizador loc = primero; loc != fin; loc = loc->siguiente)
+          {
+            c1->indice->agregar(loc, c1->inicio, recorridos);
+          }
+        },
+        recorridos);
+  }
+  contarNodos(op, recorridos);
+  liberarCadena(c2);
+  assert(indiceConsistente(c1));
+}
+
+/*
+  Quita de 'cad' los elementos cuyo componente natural es el de algún
+  elemento de 'otra' (o el de ninguno, si no 'presentes') y los retira junto
+  con sus nodos, manteniendo el índice de 'cad'.
+  Cada tramo de claves que se saltea en una de las cadenas se recorre hasta
+  8 nodos y luego se ubica con su índice, si está en modo ordenado.
+  Los nodos recorridos se cuentan en 'op'.
+  Precondición: los elementos de 'cad' y de 'otra' están ordenados por sus
+  claves y 'cad' no es 'otra'.
+*/
+static void quitarClaves(TCadena cad, TCadena otra, bool presentes,
+                         TOperacion op)
+{
+  normalizar(cad);
+  normalizar(otra);
+  assert(cad != otra);
+  assert(estaOrdenada(cad) && estaOrdenada(otra));
+  nat recorridos = 0;
+  TLocalizador loc = cad->inicio;
+  TLocalizador enOtra = otra->inicio;
+  while (loc != NULL)
+  {
+    nat clave = natInfoEnLinea(loc->dato);
+    enOtra = galopar(clave, false, enOtra, otra, recorridos);
+    bool esta = (enOtra != NULL) && (natInfoEnLinea(enOtra->dato) == clave);
+    // 'fin' es el primer nodo después del tramo de 'cad' que va desde 'loc'
+    // y cuyas claves están todas en 'otra' o todas fuera
+    TLocalizador fin;
+    if (esta)
     {
-      res = loc;
+      fin = galopar(clave, true, loc, cad, recorridos);
+    }
+    else if (enOtra != NULL)
+    {
+      fin = galopar(natInfoEnLinea(enOtra->dato), false, loc, cad, recorridos);
     }
     else
     {
-      res = NULL;
+      fin = NULL;
+    }
+    if (esta == presentes)
+    {
+      quitarSegmento(loc, (fin == NULL) ? cad->final : fin->anterior, cad, op);
     }
+    loc = fin;
   }
+  contarNodos(op, recorridos);
+  assert(indiceConsistente(cad));
+}
+
+/*
+  Intercala los elementos de 'c2' en 'c1' de manera que 'c1' quede ordenada
+  de manera no decreciente según los componentes naturales. Los elementos de
+  'c2' quedan después de los de 'c1' con el mismo componente natural.
+  Devuelve 'c1'.
+  No se debe obtener memoria (los nodos de 'c2' pasan a ser parte de 'c1').
+  Se libera la memoria asignada al resto de las estructuras de 'c2'.
+  El valor de 'c2' queda indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado, y cada tramo de 'c2' que
+  no va entre los 8 nodos siguientes de 'c1' se ubica con el índice.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log (n1 + n2)) en promedio.
+*/
+TCadena mezclar(TCadena c1, TCadena c2)
+{
+  contarLlamada(opMezclar);
+  intercalar(c1, c2, opMezclar);
+  return c1;
+}
+
+/*
+  Deja en 'c1' la unión de 'c1' y 'c2' según los componentes naturales: sus
+  elementos y los de 'c2' cuyo componente natural no es el de ningún
+  elemento de 'c1', intercalados como en 'mezclar'.
+  Devuelve 'c1'.
+  Los nodos de 'c2' que quedan pasan a ser parte de 'c1'; los demás se
+  liberan con sus elementos, como el resto de las estructuras de 'c2'.
+  El valor de 'c2' queda indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log (n1 + n2)) en promedio.
+*/
+TCadena unirCadenas(TCadena c1, TCadena c2)
+{
+  contarLlamada(opUnirCadenas);
+  quitarClaves(c2, c1, true, opUnirCadenas);
+  intercalar(c1, c2, opUnirCadenas);
+  return c1;
+}
+
+/*
+  Deja en 'c1' los elementos cuyo componente natural es el de algún elemento
+  de 'c2', en el mismo orden, y libera los demás con sus nodos.
+  Devuelve 'c1'.
+  Se libera la memoria asignada a 'c2'. El valor de 'c2' queda
+  indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c2) es
+  O(n1 log n2) en promedio.
+*/
+TCadena intersecarCadenas(TCadena c1, TCadena c2)
+{
+  contarLlamada(opIntersecarCadenas);
+  quitarClaves(c1, c2, false, opIntersecarCadenas);
+  liberarCadena(c2);
+  return c1;
+}
+
+/*
+  Quita de 'c1' los elementos cuyo componente natural es el de algún
+  elemento de 'c2' y los libera con sus nodos.
+  Devuelve 'c1'.
+  Se libera la memoria asignada a 'c2'. El valor de 'c2' queda
+  indeterminado.
+  Si estaIndexada(c1) 'c1' sigue en modo ordenado.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2)
+  y 'c1' no es 'c2'.
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' y 'n2'
+  las cantidades de elementos de 'c1' y 'c2'. Si estaIndexada(c1) es
+  O(n2 log n1 + k) en promedio, siendo 'k' la cantidad de elementos
+  quitados.
+*/
+TCadena restarCadenas(TCadena c1, TCadena c2)
+{
+  contarLlamada(opRestarCadenas);
+  quitarClaves(c1, c2, true, opRestarCadenas);
+  liberarCadena(c2);
+  return c1;
+}
+
+/*
+  Conjunto de naturales con el que 'eliminarRepetidos' reconoce las claves ya
+  vistas en una cadena desordenada: un mapa de bits si la mayor clave es a lo
+  sumo 8 veces la cantidad de elementos, y si no una tabla de dispersión.
+*/
+struct clavesVistas
+{
+  bool usaBits;
+  std::vector<bool> bits;
+  std::unordered_set<nat> tabla;
+
+  clavesVistas(nat maximo, nat n) : usaBits(maximo / 8 < n)
+  {
+    if (usaBits)
+    {
+      bits.resize((size_t)maximo + 1, false);
+    }
+    else
+    {
+      tabla.reserve(n);
+    }
+  }
+
+  // Agrega 'clave' y devuelve 'true' si y solo si ya estaba.
+  bool marcar(nat clave)
+  {
+    bool res;
+    if (usaBits)
+    {
+      res = bits[clave];
+      bits[clave] = true;
+    }
+    else
+    {
+      res = !tabla.insert(clave).second;
+    }
+    return res;
+  }
+};
+
+/*
+  Quita de 'cad' los elementos cuyo componente natural es el de otro
+  elemento de 'cad', de manera que de cada componente natural quede solo la
+  primera ocurrencia (si 'politica' es 'primeraOcurrencia') o la última (si
+  es 'ultimaOcurrencia'). Los elementos que quedan mantienen su orden.
+  Devuelve 'cad'.
+  Se libera la memoria de los elementos quitados y de sus nodos.
+  Después de la operación no hayNatsRepetidos(cad).
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+TCadena eliminarRepetidos(TCadena cad, TPoliticaRepetidos politica)
+{
+  contarLlamada(opEliminarRepetidos);
+  normalizar(cad);
+  nat recorridos = 0;
+  // primera pasada: si está ordenada se comparan vecinos, y si no hace falta
+  // la mayor clave para elegir el conjunto de claves vistas
+  bool ordenada = true;
+  nat maximo = 0, n = 0;
+  for (TLocalizador loc = cad->inicio; loc != NULL; loc = loc->siguiente)
+  {
+    nat c = natInfoEnLinea(loc->dato);
+    ordenada = ordenada && ((loc->anterior == NULL) ||
+                            (natInfoEnLinea(loc->anterior->dato) <= c));
+    maximo = (c > maximo) ? c : maximo;
+    n++;
+  }
+  recorridos += n;
+
+  // los nodos quitados se retiran juntos al final
+  nodosQuitados quitados;
+  bool adelante = (politica == primeraOcurrencia);
+  TLocalizador loc = adelante ? cad->inicio : cad->final;
+  if (ordenada)
+  {
+    // las ocurrencias de cada clave son vecinas: se quitan las que siguen a
+    // la primera que se encuentra
+    while (loc != NULL)
+    {
+      TLocalizador proximo = adelante ? loc->siguiente : loc->anterior;
+      TLocalizador previo = adelante ? loc->anterior : loc->siguiente;
+      if ((previo != NULL) &&
+          (natInfoEnLinea(previo->dato) == natInfoEnLinea(loc->dato)))
+      {
+        quitados.quitar(loc, cad);
+      }
+      loc = proximo;
+      recorridos++;
+    }
+  }
+  else
+  {
+    clavesVistas vistas(maximo, n);
+    while (loc != NULL)
+    {
+      TLocalizador proximo = adelante ? loc->siguiente : loc->anterior;
+      if (vistas.marcar(natInfoEnLinea(loc->dato)))
+      {
+        quitados.quitar(loc, cad);
+      }
+      loc = proximo;
+      recorridos++;
+    }
+  }
+
+  // el índice se rearma entero, que es O(n) como la recorrida
+  if ((quitados.primero != NULL) && (cad->indice != NULL))
+  {
+    cad->indice->construir(cad->inicio, recorridos);
+  }
+  quitados.retirarTodos();
+  contarNodos(opEliminarRepetidos, recorridos);
+  assert(indiceConsistente(cad));
+  return cad;
+}
+
+/*
+  Quita de 'cad' los elementos que no cumplen 'cumple' y los retira con sus
+  nodos. Si quita alguno rearma el índice de 'cad'.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+template <class Predicado>
+static void filtrar(TCadena cad, Predicado cumple, TOperacion op)
+{
+  nat recorridos = 0;
+  nodosQuitados quitados;
+  TLocalizador loc = cad->inicio;
+  while (loc != NULL)
+  {
+    TLocalizador proximo = loc->siguiente;
+    if (!cumple(loc->dato))
+    {
+      quitados.quitar(loc, cad);
+    }
+    loc = proximo;
+    recorridos++;
+  }
+  if ((quitados.primero != NULL) && (cad->indice != NULL))
+  {
+    cad->indice->construir(cad->inicio, recorridos);
+  }
+  quitados.retirarTodos();
+  contarNodos(op, recorridos);
+  assert(indiceConsistente(cad));
+}
+
+/*
+  Pasa a una cadena nueva, que devuelve, los elementos de 'cad' que no
+  cumplen 'cumple', en el mismo orden. Si pasa alguno rearma el índice de
+  'cad'.
+  Los nodos recorridos se cuentan en 'op'.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad'.
+*/
+template <class Predicado>
+static TCadena particionar(TCadena cad, Predicado cumple, TOperacion op)
+{
+  TCadena res = crearCadena();
+  nat recorridos = 0;
+  TLocalizador loc = cad->inicio;
+  while (loc != NULL)
+  {
+    TLocalizador proximo = loc->siguiente;
+    if (!cumple(loc->dato))
+    {
+      cad->desenlazar(loc);
+      res->enlazarAlFinal(loc);
+    }
+    loc = proximo;
+    recorridos++;
+  }
+  if (!esVaciaCadena(res) && (cad->indice != NULL))
+  {
+    cad->indice->construir(cad->inicio, recorridos);
+  }
+  contarNodos(op, recorridos);
+  assert(indiceConsistente(cad));
   return res;
 }
 
 /*
-  Devuelve el 'TLocalizador' con el que se accede al elemento cuyo componente
-  natural es el menor en el segmento que va desde 'loc' hasta finalCadena(cad).
-  Si hay más de un elemento cuyo valor es el menor el resultado accede al que
-  precede a los otros.
+  Quita de 'cad' los elementos para los que 'pred' devuelve 'false' con
+  'contexto' y libera la memoria de esos elementos y de sus nodos. Los
+  elementos que quedan mantienen su orden.
+  Devuelve 'cad'.
+  No se obtiene memoria.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad', más el de las invocaciones a 'pred'.
+*/
+TCadena filtrarCadena(TCadena cad, TPredicado pred, void *contexto)
+{
+  contarLlamada(opFiltrarCadena);
+  filtrar(
+      cad, [pred, contexto](TInfo info) { return pred(info, contexto); },
+      opFiltrarCadena);
+  return cad;
+}
+
+/*
+  Deja en 'cad' los elementos para los que 'pred' devuelve 'true' con
+  'contexto' y devuelve una 'TCadena' con los demás. Las dos cadenas
+  mantienen el orden relativo de sus elementos.
+  No se obtiene memoria para los nodos (los que pasan al resultado son los de
+  'cad').
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado. El resultado no está en
+  modo ordenado.
+  El tiempo de ejecución es O(n) en promedio, siendo 'n' la cantidad de
+  elementos en 'cad', más el de las invocaciones a 'pred'.
+*/
+TCadena particionarCadena(TCadena cad, TPredicado pred, void *contexto)
+{
+  contarLlamada(opParticionarCadena);
+  normalizar(cad);
+  return particionar(
+      cad, [pred, contexto](TInfo info) { return pred(info, contexto); },
+      opParticionarCadena);
+}
+
+/*
+  Quita de 'cad' los elementos cuyo componente natural no está entre 'menor'
+  y 'mayor', incluidos, y libera la memoria de esos elementos y de sus nodos.
+  Es 'filtrarCadena' con ese predicado, pero si 'cad' está en modo ordenado
+  los elementos quitados forman un prefijo y un sufijo que se ubican con el
+  índice.
+  Devuelve 'cad'.
+  No se obtiene memoria.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado.
+  El tiempo de ejecución es O(log n + k) en promedio si estaIndexada(cad),
+  siendo 'k' la cantidad de elementos quitados, y si no O(n) en el peor caso,
+  siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena filtrarRango(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opFiltrarRango);
+  if (cad->indice == NULL)
+  {
+    filtrar(
+        cad,
+        [menor, mayor](TInfo info)
+        {
+          nat c = natInfoEnLinea(info);
+          return (menor <= c) && (c <= mayor);
+        },
+        opFiltrarRango);
+  }
+  else if (!esVaciaCadena(cad))
+  {
+    TLocalizador desde = cota(menor, false, cad, opFiltrarRango);
+    if ((desde == NULL) || (natInfoEnLinea(desde->dato) > mayor))
+    {
+      quitarSegmento(cad->inicio, cad->final, cad, opFiltrarRango);
+    }
+    else
+    {
+      TLocalizador despues = cota(mayor, true, cad, opFiltrarRango);
+      if (despues != NULL)
+      {
+        quitarSegmento(despues, cad->final, cad, opFiltrarRango);
+      }
+      if (desde != cad->inicio)
+      {
+        quitarSegmento(cad->inicio, desde->anterior, cad, opFiltrarRango);
+      }
+    }
+  }
+  assert(indiceConsistente(cad));
+  return cad;
+}
+
+/*
+  Deja en 'cad' los elementos cuyo componente natural está entre 'menor' y
+  'mayor', incluidos, y devuelve una 'TCadena' con los demás, como
+  'particionarCadena' con ese predicado. Si 'cad' está en modo ordenado los
+  elementos que pasan al resultado forman un prefijo y un sufijo que se
+  ubican con el índice.
+  No se obtiene memoria para los nodos.
+  Si estaIndexada(cad) 'cad' sigue en modo ordenado. El resultado no está en
+  modo ordenado.
+  El tiempo de ejecución es O(log n + k) en promedio si estaIndexada(cad),
+  siendo 'k' la cantidad de elementos del resultado, y si no O(n) en el peor
+  caso, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena particionarRango(nat menor, nat mayor, TCadena cad)
+{
+  contarLlamada(opParticionarRango);
+  normalizar(cad);
+  TCadena res;
+  if (cad->indice == NULL)
+  {
+    res = particionar(
+        cad,
+        [menor, mayor](TInfo info)
+        {
+          nat c = natInfoEnLinea(info);
+          return (menor <= c) && (c <= mayor);
+        },
+        opParticionarRango);
+  }
+  else
+  {
+    res = crearCadena();
+    TLocalizador desde = cota(menor, false, cad, opParticionarRango);
+    if ((desde == NULL) || (natInfoEnLinea(desde->dato) > mayor))
+    {
+      if (!esVaciaCadena(cad))
+      {
+        pasarSegmentoAlFinal(cad->inicio, cad->final, cad, res,
+                             opParticionarRango);
+      }
+    }
+    else
+    {
+      // el sufijo se ubica antes de pasar el prefijo, que va primero
+      TLocalizador despues = cota(mayor, true, cad, opParticionarRango);
+      if (desde != cad->inicio)
+      {
+        pasarSegmentoAlFinal(cad->inicio, desde->anterior, cad, res,
+                             opParticionarRango);
+      }
+      if (despues != NULL)
+      {
+        pasarSegmentoAlFinal(despues, cad->final, cad, res,
+                             opParticionarRango);
+      }
+    }
+  }
+  assert(indiceConsistente(cad));
+  return res;
+}
+
+/*
+  Invierte el orden de los elementos de 'cad': el primero pasa a ser el
+  último y cada elemento pasa a seguir al que lo seguía. No se modifican los
+  enlaces sino el sentido en que se recorren, y los localizadores siguen
+  accediendo a los mismos elementos.
+  Devuelve 'cad'.
+  Si estaIndexada(cad) 'cad' sale del modo ordenado.
+  El tiempo de ejecución en el peor caso es O(1) si no estaIndexada(cad), y
+  si no O(n) en promedio, siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena invertirCadena(TCadena cad)
+{
+  contarLlamada(opInvertirCadena);
+  // el índice supone el orden de los enlaces
+  desindexar(cad);
+  cad->invertida = !cad->invertida;
+  return cad;
+}
+
+/*
+  Si 'cad' está invertida invierte sus enlaces, de manera que el orden de los
+  enlaces vuelva a ser el de los elementos. Los elementos, su orden y los
+  localizadores no cambian. Se usa antes de las operaciones que recorren los
+  enlaces en orden.
+  Devuelve 'cad'.
+  El tiempo de ejecución en el peor caso es O(1) si 'cad' no está invertida,
+  y si no O(n), siendo 'n' la cantidad de elementos en 'cad'.
+*/
+TCadena normalizar(TCadena cad)
+{
+  contarLlamada(opNormalizar);
+  if (cad->invertida)
+  {
+    nat recorridos = 0;
+    cad->invertirEnlaces(recorridos);
+    cad->invertida = false;
+    contarNodos(opNormalizar, recorridos);
+  }
+  return cad;
+}
+
+/*
+  Pasa a una 'TCadena' nueva, que devuelve, los elementos de 'cad' que siguen
+  a 'loc', manteniendo su orden. 'loc' pasa a ser el final de 'cad'. Es la
+  operación inversa de 'insertarSegmentoDespues'.
+  No se obtiene memoria para los nodos (los que pasan al resultado son los de
+  'cad', y los localizadores siguen accediendo a los mismos elementos).
+  Si estaIndexada(cad) las dos cadenas quedan en modo ordenado.
   Precondición: localizadorEnCadena(loc, cad).
-  El tiempo de ejecución en el peor caso es O(n), siendo 'n' la cantidad de
+  El tiempo de ejecución es O(1) en el peor caso si no estaIndexada(cad) y
+  O(log n) en promedio si estaIndexada(cad), siendo 'n' la cantidad de
   elementos en 'cad'.
 */
-TLocalizador menorEnCadena(TLocalizador loc, TCadena cad)
+TCadena partirCadena(TLocalizador loc, TCadena cad)
 {
-  TLocalizador res = loc;
-  TLocalizador aux = loc;
-  nat x = natInfo(loc->dato);
-  while (aux != NULL)
+  contarLlamada(opPartirCadena);
+  assert(localizadorEnCadena(loc, cad));
+  TCadena res = crearCadena();
+  res->invertida = cad->invertida;
+  if (cad->indice != NULL)
+  {
+    contarBytes(sizeof(TIndice));
+    res->indice = new TIndice;
+  }
+  TLocalizador desde = nodoSiguiente(loc, cad);
+  if (desde != NULL)
   {
-    if (natInfo(aux->dato) < x)
+    TIndice::Ubicacion u, ur;
+    if (cad->indice != NULL)
     {
-      x = natInfo(aux->dato);
-      res = aux;
+      nat recorridos = 0;
+      cad->indice->partir(desde, cad->inicio, *res->indice, u, ur,
+                          recorridos);
+      contarNodos(opPartirCadena, recorridos);
     }
-    aux= aux->siguiente;
+    // en una cadena invertida lo que sigue a 'loc' son los nodos anteriores
+    if (cad->invertida)
+    {
+      cad->moverSegmento(cad->inicio, desde, *res, NULL);
+    }
+    else
+    {
+      cad->moverSegmento(desde, cad->final, *res, NULL);
+    }
+    recalcularIndice(u, cad, opPartirCadena);
+    recalcularIndice(ur, res, opPartirCadena);
   }
+  assert(indiceConsistente(cad));
+  assert(indiceConsistente(res));
   return res;
-}
\ No newline at end of file
+}
+
+/*
+  Quita de 'origen' los elementos que se encuentran entre 'desde' y 'hasta',
+  incluidos, y los inserta en 'destino', que puede ser 'origen', manteniendo
+  su orden, inmediatamente después de 'destinoLoc', o al inicio si
+  'destinoLoc' no es válido. Los nodos pasan con sus enlaces, por lo que los
+  localizadores siguen accediendo a los mismos elementos.
+  Devuelve 'destino'.
+  No se obtiene memoria.
+  Si esVaciaCadena(destino) 'destinoLoc' es ignorado.
+  'destino' sale del modo ordenado. Si estaIndexada(origen) y 'destino' no es
+  'origen', 'origen' sigue en modo ordenado.
+  Precondición: precedeEnCadena(desde, hasta, origen), y 'destinoLoc' no es
+  válido, o localizadorEnCadena(destinoLoc, destino) y 'destinoLoc' no está
+  entre 'desde' y 'hasta'.
+  El tiempo de ejecución en el peor caso es O(1) si ninguna de las dos está
+  en modo ordenado y no están una invertida y la otra no (ver
+  'invertirCadena'). Si estaIndexada(origen) se suma O(log n + k) en
+  promedio, si estaIndexada(destino) O(m), y si una está invertida y la otra
+  no O(k), siendo 'n' y 'm' la cantidad de elementos en 'origen' y en
+  'destino' y 'k' la del segmento.
+*/
+TCadena moverSegmento(TLocalizador desde, TLocalizador hasta, TCadena origen,
+                      TLocalizador destinoLoc, TCadena destino)
+{
+  contarLlamada(opMoverSegmento);
+  assert(precedeEnCadena(desde, hasta, origen));
+  if (esVaciaCadena(destino))
+  {
+    destinoLoc = NULL;
+    destino->invertida = origen->invertida;
+  }
+  // el índice de 'destino' supone el orden de sus enlaces
+  desindexar(destino);
+  // extremos del segmento en el orden de los enlaces de 'origen'
+  TLocalizador primero = origen->invertida ? hasta : desde;
+  TLocalizador ultimo = origen->invertida ? desde : hasta;
+  TIndice::Ubicacion u;
+  desindexarNodos(primero, ultimo, origen, u, opMoverSegmento);
+  // en una cadena invertida lo que sigue a 'destinoLoc' va antes en los
+  // enlaces, y el inicio es el final de los enlaces
+  TLocalizador antes = destinoLoc;
+  if (destino->invertida)
+  {
+    antes = (destinoLoc == NULL) ? destino->final : destinoLoc->anterior;
+  }
+  if (origen->invertida == destino->invertida)
+  {
+    // si 'antes' es 'ultimo' el segmento ya está en su lugar
+    if (antes != ultimo)
+    {
+      origen->moverSegmento(primero, ultimo, *destino, antes);
+    }
+  }
+  else
+  {
+    // los nodos se pasan de a uno, en orden, para invertir sus enlaces
+    nat recorridos = 0;
+    bool fin = false;
+    while (!fin)
+    {
+      TLocalizador loc = desde;
+      fin = (loc == hasta);
+      desde = nodoSiguiente(loc, origen);
+      origen->moverSegmento(loc, loc, *destino, antes);
+      if (!destino->invertida)
+      {
+        antes = loc;
+      }
+      recorridos++;
+    }
+    contarNodos(opMoverSegmento, recorridos);
+  }
+  recalcularIndice(u, origen, opMoverSegmento);
+  assert(indiceConsistente(origen));
+  return destino;
+}
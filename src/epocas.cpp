@@ -0,0 +1,181 @@
+/*
+  Módulo de implementación de 'epocas'.
+
+  Cada lector ocupa una ranura en la que anuncia la época global vigente al
+  empezar su recorrido (0 indica que la ranura no tiene un recorrido abierto).
+  Los elementos retirados se encolan junto con la época en la que se
+  retiraron; como la época global solo crece, la cola queda ordenada y se
+  libera siempre desde el principio.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/epocas.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <mutex>
+
+struct retirado {
+  void *elem;
+  void *contexto;
+  TLiberador liberador;
+  unsigned long epoca;
+  retirado *siguiente;
+};
+
+static std::atomic<unsigned long> epocaGlobal(1);
+static std::atomic<bool> ocupadas[MAX_LECTORES];
+static std::atomic<unsigned long> anunciadas[MAX_LECTORES];
+
+/*
+  Ranura del hilo actual (-1 si todavía no tiene). Al terminar el hilo se
+  destruye y deja la ranura libre para otro.
+*/
+struct ranuraHilo {
+  int indice = -1;
+  ~ranuraHilo() {
+    if (indice >= 0)
+      ocupadas[indice].store(false, std::memory_order_release);
+  }
+};
+
+static thread_local ranuraHilo ranura;
+static thread_local nat anidamiento = 0;
+
+static std::mutex cerrojo;
+static retirado *primero = NULL;
+static retirado *ultimo = NULL;
+static std::atomic<nat> profundidad(0);
+
+#ifdef __SANITIZE_THREAD__
+static std::atomic<unsigned long> sincronizacion(0);
+#endif
+
+/*
+  Ordena las escrituras anteriores del hilo antes que sus lecturas
+  siguientes. ThreadSanitizer no modela 'atomic_thread_fence', por lo que al
+  compilar con él se usa una modificación de 'sincronizacion': como todas
+  quedan en un orden total, quien la hace después ve lo escrito por quien la
+  hizo antes.
+*/
+static void barrera() {
+#ifdef __SANITIZE_THREAD__
+  sincronizacion.fetch_add(1, std::memory_order_acq_rel);
+#else
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/*
+  Devuelve la ranura del hilo actual, reservándola si todavía no tiene.
+  Si están todas ocupadas aborta: esperar a que se libere una podría no
+  terminar nunca y seguir sin anunciarse permitiría liberar lo que el hilo
+  está leyendo.
+*/
+static int obtenerRanura() {
+  for (int i = 0; (ranura.indice < 0) && (i < MAX_LECTORES); i++) {
+    bool libre = false;
+    if (ocupadas[i].compare_exchange_strong(libre, true))
+      ranura.indice = i;
+  }
+  if (ranura.indice < 0) {
+    fprintf(stderr, "epocas: hay más de %d hilos lectores.\n", MAX_LECTORES);
+    abort();
+  }
+  return ranura.indice;
+}
+
+/*
+  Devuelve la menor época anunciada por un lector activo, o 0 si no hay
+  lectores activos.
+*/
+static unsigned long menorEpocaActiva() {
+  unsigned long menor = 0;
+  for (int i = 0; i < MAX_LECTORES; i++) {
+    unsigned long e = anunciadas[i].load();
+    if ((e != 0) && ((menor == 0) || (e < menor)))
+      menor = e;
+  }
+  return menor;
+}
+
+void entrarLectura() {
+  if (anidamiento == 0) {
+    int r = obtenerRanura();
+    anunciadas[r].store(epocaGlobal.load());
+    // el anuncio debe ser visible antes de leer cualquier enlace
+    barrera();
+  }
+  anidamiento++;
+}
+
+void salirLectura() {
+  assert(anidamiento > 0);
+  anidamiento--;
+  if (anidamiento == 0) {
+    anunciadas[ranura.indice].store(0, std::memory_order_release);
+    if (profundidad.load() > 0)
+      reclamar();
+  }
+}
+
+void retirar(void *elem, void *contexto, TLiberador liberador) {
+  // el desenlace hecho por quien retira debe ser visible antes de revisar
+  // los anuncios de los lectores
+  barrera();
+  if ((profundidad.load() == 0) && (menorEpocaActiva() == 0)) {
+    liberador(elem, contexto);
+  } else {
+    retirado *nuevo = new retirado;
+    nuevo->elem = elem;
+    nuevo->contexto = contexto;
+    nuevo->liberador = liberador;
+    nuevo->siguiente = NULL;
+    {
+      std::lock_guard<std::mutex> guardia(cerrojo);
+      nuevo->epoca = epocaGlobal.fetch_add(1);
+      if (ultimo == NULL)
+        primero = nuevo;
+      else
+        ultimo->siguiente = nuevo;
+      ultimo = nuevo;
+      profundidad++;
+    }
+    reclamar();
+  }
+}
+
+void reclamar() {
+  retirado *liberables = NULL;
+  {
+    std::lock_guard<std::mutex> guardia(cerrojo);
+    unsigned long menor = menorEpocaActiva();
+    retirado *fin = NULL;
+    while ((primero != NULL) && ((menor == 0) || (primero->epoca < menor))) {
+      if (fin == NULL)
+        liberables = primero;
+      fin = primero;
+      primero = primero->siguiente;
+      profundidad--;
+    }
+    if (fin != NULL)
+      fin->siguiente = NULL;
+    if (primero == NULL)
+      ultimo = NULL;
+  }
+  while (liberables != NULL) {
+    retirado *aux = liberables;
+    liberables = liberables->siguiente;
+    aux->liberador(aux->elem, aux->contexto);
+    delete aux;
+  }
+}
+
+nat profundidadRetiro() { return profundidad.load(); }
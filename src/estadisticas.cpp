@@ -0,0 +1,197 @@
+/*
+  Módulo de implementación de 'estadisticas'.
+
+  Los contadores de cada hilo se crean la primera vez que el hilo cuenta y se
+  enlazan en una lista que recorren las consultas. No se liberan al terminar
+  el hilo, para que sus cuentas sigan sumando.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/estadisticas.h"
+#include "../include/salida.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+
+#include <mutex>
+
+static const char *nombres[CANT_OPERACIONES] = {
+    "esLocalizador",
+    "crearCadena",
+    "liberarCadena",
+    "esVaciaCadena",
+    "inicioCadena",
+    "finalCadena",
+    "infoCadena",
+    "siguiente",
+    "anterior",
+    "esFinalCadena",
+    "esInicioCadena",
+    "insertarAlFinal",
+    "insertarAntes",
+    "removerDeCadena",
+    "imprimirCadena",
+    "kesimo",
+    "localizadorEnCadena",
+    "precedeEnCadena",
+    "insertarSegmentoDespues",
+    "copiarSegmento",
+    "borrarSegmento",
+    "cambiarEnCadena",
+    "intercambiar",
+    "siguienteClave",
+    "anteriorClave",
+    "menorEnCadena",
+    "ordenarCadena",
+    "indexarCadena",
+    "estaIndexada",
+    "insertarOrdenado",
+    "buscarClave",
+    "cotaInferior",
+    "cotaSuperior",
+    "galoparClave",
+    "contarEnRango",
+    "sumaReales",
+    "minReal",
+    "maxReal",
+    "mezclar",
+    "unirCadenas",
+    "intersecarCadenas",
+    "restarCadenas",
+    "eliminarRepetidos",
+    "filtrarCadena",
+    "particionarCadena",
+    "filtrarRango",
+    "particionarRango",
+    "invertirCadena",
+    "normalizar",
+    "partirCadena",
+    "moverSegmento",
+    "pertenece",
+    "longitud",
+    "estaOrdenadaPorNaturales",
+    "hayNatsRepetidos",
+    "sonIgualesCadena",
+    "concatenar",
+    "ordenar",
+    "cambiarTodos",
+    "subCadena",
+    "unionCadenas",
+    "interseccionCadenas",
+    "diferenciaCadenas",
+};
+
+const char *nombreOperacion(TOperacion op) {
+  assert(op < CANT_OPERACIONES);
+  return nombres[op];
+}
+
+#ifndef SIN_ESTADISTICAS
+
+thread_local repContadores *contadoresDelHilo = NULL;
+
+static std::mutex cerrojo;
+static repContadores *todos = NULL;
+
+repContadores *registrarContadores() {
+  repContadores *res = new repContadores;
+  for (nat op = 0; op < CANT_OPERACIONES; op++) {
+    res->llamadas[op] = 0;
+    res->nodos[op] = 0;
+  }
+  res->infosCreadas = 0;
+  res->infosLiberadas = 0;
+  res->bytes = 0;
+  std::lock_guard<std::mutex> guardia(cerrojo);
+  res->siguiente = todos;
+  todos = res;
+  contadoresDelHilo = res;
+  return res;
+}
+
+/*
+  Devuelve la suma de 'campo' en los contadores de todos los hilos.
+*/
+template <class T, class F> static T sumar(F campo) {
+  std::lock_guard<std::mutex> guardia(cerrojo);
+  T res = 0;
+  for (repContadores *c = todos; c != NULL; c = c->siguiente)
+    res += campo(*c).load(std::memory_order_relaxed);
+  return res;
+}
+
+bool hayEstadisticas() { return true; }
+
+unsigned long llamadasOperacion(TOperacion op) {
+  return sumar<unsigned long>(
+      [op](repContadores &c) -> std::atomic<unsigned long> & {
+        return c.llamadas[op];
+      });
+}
+
+unsigned long nodosOperacion(TOperacion op) {
+  return sumar<unsigned long>(
+      [op](repContadores &c) -> std::atomic<unsigned long> & {
+        return c.nodos[op];
+      });
+}
+
+unsigned long infosCreadas() {
+  return sumar<unsigned long>(
+      [](repContadores &c) -> std::atomic<unsigned long> & {
+        return c.infosCreadas;
+      });
+}
+
+unsigned long infosLiberadas() {
+  return sumar<unsigned long>(
+      [](repContadores &c) -> std::atomic<unsigned long> & {
+        return c.infosLiberadas;
+      });
+}
+
+long bytesEnUso() {
+  return sumar<long>(
+      [](repContadores &c) -> std::atomic<long> & { return c.bytes; });
+}
+
+void reiniciarEstadisticas() {
+  std::lock_guard<std::mutex> guardia(cerrojo);
+  for (repContadores *c = todos; c != NULL; c = c->siguiente)
+    for (nat op = 0; op < CANT_OPERACIONES; op++) {
+      c->llamadas[op].store(0, std::memory_order_relaxed);
+      c->nodos[op].store(0, std::memory_order_relaxed);
+    }
+}
+
+void imprimirEstadisticasEnBuffer(TBufferSalida buf) {
+  agregarFormato(buf, "%-27s %12s %14s\n", "Operación", "Llamadas", "Nodos");
+  for (nat op = 0; op < CANT_OPERACIONES; op++) {
+    unsigned long llamadas = llamadasOperacion((TOperacion)op);
+    if (llamadas > 0)
+      agregarFormato(buf, "%-26s %12lu %14lu\n", nombres[op], llamadas,
+                     nodosOperacion((TOperacion)op));
+  }
+  agregarFormato(buf, "TInfo creados: %lu, liberados: %lu.\n", infosCreadas(),
+                 infosLiberadas());
+  agregarFormato(buf, "Bytes en uso: %ld.\n", bytesEnUso());
+}
+
+#else
+
+bool hayEstadisticas() { return false; }
+unsigned long llamadasOperacion(TOperacion op) { return 0; }
+unsigned long nodosOperacion(TOperacion op) { return 0; }
+unsigned long infosCreadas() { return 0; }
+unsigned long infosLiberadas() { return 0; }
+long bytesEnUso() { return 0; }
+void reiniciarEstadisticas() {}
+
+void imprimirEstadisticasEnBuffer(TBufferSalida buf) {
+  agregarFormato(buf, "Estadísticas no disponibles (compilado con "
+                      "SIN_ESTADISTICAS).\n");
+}
+
+#endif
@@ -2,59 +2,111 @@
   Módulo de implementación de `TInfo'.
 
   Se implementa struct rep_info como un registro con dos campos, uno natural y
-  otro double.
+  otro double. Se define en infoInterna.h para que cadena.cpp pueda leer los
+  campos en línea.
 
   Laboratorio de Programación 2.
   InCo-FIng-UDELAR
 */
 
 #include "../include/info.h"
+#include "../include/infoInterna.h"
 #include "../include/utils.h"
+#include "../include/estadisticas.h"
 
-#include <stdio.h>  // sprintf
 #include <stdlib.h>
-#include <string.h> // strcpy, strcat
+#include <string.h> // memcpy
 
-struct repInfo {
-  nat n;
-  double r;
-};
+#include <charconv> // to_chars
 
-TInfo crearInfo(nat natural, double real) {
+TInfo crearInfo(nat natural, double real, TLugar lugar) {
   TInfo nueva = (TInfo)malloc(sizeof(struct repInfo));
   nueva->n = natural;
   nueva->r = real;
+  registrarReserva(nueva, sizeof(struct repInfo), memInfo, lugar);
+  contarInfoCreado(sizeof(struct repInfo));
   return nueva;
 }
 
-TInfo copiaInfo(TInfo info) {
+TInfo copiaInfo(TInfo info, TLugar lugar) {
   TInfo copia = (TInfo)malloc(sizeof(struct repInfo));
   *copia = *info;
+  registrarReserva(copia, sizeof(struct repInfo), memInfo, lugar);
+  contarInfoCreado(sizeof(struct repInfo));
   return copia;
 }
 
-void liberarInfo(TInfo info) { free(info); };
+void liberarInfo(TInfo info, TLugar lugar) {
+  if (registrarLiberacion(info, memInfo, lugar)) {
+    if (info != NULL)
+      contarInfoLiberado(sizeof(struct repInfo));
+    free(info);
+  }
+};
 
-nat natInfo(TInfo info) { return info->n; }
+nat natInfo(TInfo info) { return natInfoEnLinea(info); }
 
-double realInfo(TInfo info) { return info->r; }
+double realInfo(TInfo info) { return realInfoEnLinea(info); }
 
 bool sonIgualesInfo(TInfo i1, TInfo i2) {
   return (i1->n == i2->n) && (i1->r == i2->r);
 }
 
-ArregloChars infoATexto(TInfo info) {
-  char copia_nat[11];
-  sprintf(copia_nat, "%d", info->n);
-  char copia_real[10];
-  sprintf(copia_real, "%4.2lf", info->r);
-
-  ArregloChars texto = new char[strlen(copia_nat) + strlen(copia_real) + 5];
-  strcpy(texto, "(");
-  strcat(texto, copia_nat);
-  strcat(texto, ",");
-  strcat(texto, copia_real);
-  strcat(texto, ")");
+ArregloChars infoATexto(TInfo info, TLugar lugar) {
+  char texto_info[MAX_TEXTO_INFO];
+  size_t largo = infoATextoEn(info, texto_info, MAX_TEXTO_INFO);
+  ArregloChars texto = new char[largo + 1];
+  registrarReserva(texto, largo + 1, memTextoInfo, lugar);
+  memcpy(texto, texto_info, largo + 1);
   return texto;
 }
 
+void liberarTextoInfo(ArregloChars texto, TLugar lugar) {
+  if (registrarLiberacion(texto, memTextoInfo, lugar))
+    delete[] texto;
+}
+
+/*
+  Escribe el texto de 'info' a partir de 'ini' sin pasar de 'fin' y devuelve
+  el puntero al carácter siguiente al último escrito, o NULL si no entra.
+  No escribe el '\0' final.
+*/
+static char *escribirInfo(TInfo info, char *ini, char *fin) {
+  char *p = ini;
+  if (p < fin) {
+    *p++ = '(';
+    // como con "%d", el natural se muestra con signo
+    std::to_chars_result r = std::to_chars(p, fin, (int)info->n);
+    p = (r.ec == std::errc()) ? r.ptr : NULL;
+  }
+  if ((p != NULL) && (p < fin)) {
+    *p++ = ',';
+    std::to_chars_result r =
+        std::to_chars(p, fin, info->r, std::chars_format::fixed, 2);
+    p = (r.ec == std::errc()) ? r.ptr : NULL;
+  }
+  if ((p != NULL) && (p < fin))
+    *p++ = ')';
+  else
+    p = NULL;
+  return p;
+}
+
+size_t infoATextoEn(TInfo info, char *buf, size_t cap) {
+  return infosATextoEn(&info, 1, buf, cap);
+}
+
+size_t infosATextoEn(const TInfo *infos, nat cantidad, char *buf, size_t cap) {
+  size_t res = 0;
+  if (cap > 0) {
+    // se reserva el lugar del '\0'
+    char *fin = buf + cap - 1;
+    char *p = buf;
+    for (nat i = 0; (p != NULL) && (i < cantidad); i++)
+      p = escribirInfo(infos[i], p, fin);
+    if (p != NULL)
+      res = p - buf;
+    buf[res] = '\0';
+  }
+  return res;
+}
@@ -0,0 +1,699 @@
+/*
+  Módulo de implementación de 'interprete'.
+
+  Cada comando tiene una función que lo ejecuta. La tabla 'comandos' asocia
+  los nombres con esas funciones; al compilar se verifica que esté ordenada
+  según 'strcmp' (y por lo tanto sin repetidos) y se arma sobre ella un índice
+  de dispersión perfecta.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/interprete.h"
+#include "../include/cadena.h"
+#include "../include/estadisticas.h"
+#include "../include/info.h"
+#include "../include/persistencia.h"
+#include "../include/salida.h"
+#include "../include/usoTads.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm> // sort, adjacent_find
+#include <vector>
+
+#define MAX_LINEA 256
+// Cantidad máxima de elementos de una cadena que se lee como parámetro en una
+// sesión remota.
+#define MAX_LEIDOS (1 << 16)
+
+struct repSesion {
+  TCadena cad;
+  TLocalizador loc;
+  TBufferSalida salida; // NULL si se imprime en la salida estándar
+  bool terminada;
+  bool remota; // ver 'exigir'
+};
+
+/*
+  Imprime en la salida de 's' el texto que imprimiría 'printf' con 'formato'
+  y los parámetros siguientes.
+*/
+static void mostrar(TSesion s, const char *formato, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void mostrar(TSesion s, const char *formato, ...) {
+  va_list args;
+  va_start(args, formato);
+  if (s->salida == NULL)
+    vprintf(formato, args);
+  else
+    agregarFormatoV(s->salida, formato, args);
+  va_end(args);
+}
+
+/*
+  Verifica la precondición 'condicion()' de un comando. En una sesión local se
+  asume que los comandos la cumplen y solo se verifica con 'assert'. En una
+  sesión remota, si no se cumple se imprime "Error: " seguido de 'motivo' y
+  se devuelve 'false', para que el comando no se ejecute.
+*/
+template <class Condicion>
+static bool exigir(TSesion s, Condicion condicion, const char *motivo) {
+  bool res = true;
+  if (s->remota) {
+    res = condicion();
+    if (!res)
+      mostrar(s, "Error: %s.\n", motivo);
+  } else {
+    assert(condicion());
+  }
+  return res;
+}
+
+/*
+  Lee un TInfo desde la entrada estándar y lo deja en 'info'.
+  Se asume que la antrada cumple con el formato descrito en 'infoATexto' del
+  módulo 'info'; si no (en una sesión remota) devuelve 'false' sin crearlo.
+ */
+static bool leerInfo(TSesion s, TInfo &info) {
+  nat natural;
+  double real;
+  bool bienFormado = leerParNatReal(&natural, &real);
+  bool res = exigir(s, [=] { return bienFormado; }, "elemento mal formado");
+  if (res)
+    info = crearInfo(natural, real);
+  return res;
+} // leerInfo
+
+/*
+  Lee una TCadena desde la entrada estándar y la deja en 'cad'.
+  Se asume que en la entrada hay un espacio en blanco después de cada elemento.
+  En una sesión remota devuelve 'false', sin crear la cadena, si algún
+  elemento está mal formado o si son más de MAX_LEIDOS.
+ */
+static bool leerCadena(TSesion s, TCadena &cad) {
+  nat n = leerNat();
+  // en una sesión local no hay límite
+  bool res = !s->remota || exigir(s, [=] { return n <= MAX_LEIDOS; },
+                                  "demasiados elementos");
+  if (res) {
+    cad = crearCadena();
+    for (nat i = 1; res && (i <= n); i++) {
+      TInfo info;
+      res = leerInfo(s, info);
+      if (res)
+        cad = insertarAlFinal(info, cad);
+    }
+    if (!res)
+      liberarCadena(cad);
+  }
+  return res;
+} // leerCadena
+
+struct tArregloTope {
+  ArregloNats datos;
+  nat tope;
+};
+typedef struct tArregloTope TArregloTope;
+
+/*
+  Lee una secuencia de nat desde la entrada estándar y las devuelve en un
+  arreglo con tope.
+  Primero lee la cantidad de elemntos.
+  Después de cada elemento hay un espacio en blanco.
+  La secuencia está ordenada de manera creciente estricta según los campos
+  naturales.
+ */
+TArregloTope leerArregloOrdenado() {
+  nat n = leerNat();
+  TArregloTope res;
+  res.tope = n;
+  if (n == 0) {
+    res.datos = NULL;
+  } else {
+    res.datos = new nat[n];// obtMemNats(n);
+    for (nat i = 0; i < n; i++) {
+      res.datos[i] = leerNat();
+    }
+  }
+
+  bool estaOrdenado = true;
+  nat pos = 0;
+  while (estaOrdenado && pos + 1 < res.tope) {
+    if (res.datos[pos] < res.datos[pos + 1])
+      pos++;
+    else
+      estaOrdenado = false;
+  }
+  if (!estaOrdenado) {
+    printf("Secuencia no ordenada. \n");
+    delete [] res.datos;// libMemNats(res.datos);
+    res.tope = 0;
+  }
+  return res;
+}
+
+/*
+  Imprime 'cad' en la salida de 's' con el formato de 'imprimirCadena'.
+*/
+static void mostrarCadena(TSesion s, TCadena cad) {
+  if (s->salida == NULL)
+    imprimirCadena(cad);
+  else
+    imprimirCadenaEnBuffer(s->salida, cad);
+}
+
+/*
+  Precondiciones de los comandos que usan 'loc'.
+*/
+static bool exigirLoc(TSesion s) {
+  return exigir(s, [=] { return localizadorEnCadena(s->loc, s->cad); },
+                "loc no pertenece a cad");
+}
+
+static bool exigirLocOVacia(TSesion s) {
+  return exigir(s,
+                [=] {
+                  return esVaciaCadena(s->cad) ||
+                         localizadorEnCadena(s->loc, s->cad);
+                },
+                "loc no pertenece a cad");
+}
+
+/*
+  Precondición de los comandos que usan el segmento de las posiciones 'k1' a
+  'k2' de 'cad'.
+*/
+static bool exigirSegmento(TSesion s, nat k1, nat k2) {
+  return exigir(s,
+                [=] {
+                  return esVaciaCadena(s->cad) ||
+                         ((1 <= k1) && (k1 <= k2) && (k2 <= longitud(s->cad)));
+                },
+                "posiciones fuera de cad");
+}
+
+static void ejecutarFin(TSesion s) {
+  s->terminada = true;
+  mostrar(s, "Fin.\n");
+}
+
+static void ejecutarComentario(TSesion s) {
+  char restoLinea[MAX_LINEA];
+  leerRestoLineaAcotado(restoLinea, MAX_LINEA);
+  mostrar(s, "# %s.\n", restoLinea);
+}
+
+
+// operaciones de cadena
+
+static void ejecutarEsLocalizador(TSesion s) {
+  mostrar(s, "loc%s válido.\n", esLocalizador(s->loc) ? "" : " no");
+}
+
+static void ejecutarEsVaciaCadena(TSesion s) {
+  mostrar(s, "cad%s.\n", esVaciaCadena(s->cad) ? " vacia" : " no vacia");
+}
+
+static void ejecutarInicioCadena(TSesion s) {
+  s->loc = inicioCadena(s->cad);
+  mostrar(s, "loc al inicio.\n");
+}
+
+static void ejecutarFinalCadena(TSesion s) {
+  s->loc = finalCadena(s->cad);
+  mostrar(s, "loc al final.\n");
+}
+
+static void ejecutarInfoCadena(TSesion s) {
+  if (exigirLoc(s)) {
+    char txtInfo[MAX_TEXTO_INFO];
+    infoATextoEn(infoCadena(s->loc, s->cad), txtInfo, MAX_TEXTO_INFO);
+    mostrar(s, "%s\n", txtInfo);
+  }
+}
+
+static void ejecutarEsFinalCadena(TSesion s) {
+  mostrar(s, "loc%s es final de cad.\n", esFinalCadena(s->loc, s->cad) ? "" : " no");
+}
+
+static void ejecutarEsInicioCadena(TSesion s) {
+  mostrar(s, "loc%s es incio de cad.\n", esInicioCadena(s->loc, s->cad) ? "" : " no");
+}
+
+static void ejecutarSiguiente(TSesion s) {
+  if (exigirLoc(s)) {
+    s->loc = siguiente(s->loc, s->cad);
+    mostrar(s, "loc al siguiente.\n");
+  }
+}
+
+static void ejecutarAnterior(TSesion s) {
+  if (exigirLoc(s)) {
+    s->loc = anterior(s->loc, s->cad);
+    mostrar(s, "loc al anterior.\n");
+  }
+}
+
+static void ejecutarInsertarAlFinal(TSesion s) {
+  TInfo info;
+  if (leerInfo(s, info)) {
+    s->cad = insertarAlFinal(info, s->cad);
+    mostrar(s, "Insertado al final.\n");
+  }
+}
+
+static void ejecutarInsertarAntes(TSesion s) {
+  TInfo info;
+  if (exigirLoc(s) && leerInfo(s, info)) {
+    s->cad = insertarAntes(info, s->loc, s->cad);
+    mostrar(s, "Insertado antes de loc.\n");
+  }
+}
+
+static void ejecutarRemoverDeCadena(TSesion s) {
+  if (exigirLoc(s)) {
+    s->cad = removerDeCadena(s->loc, s->cad);
+    mostrar(s, "Removido.\n");
+  }
+}
+
+static void ejecutarImprimirCadena(TSesion s) {
+  mostrarCadena(s, s->cad);
+}
+
+static void ejecutarKesimo(TSesion s) {
+  nat k = leerNat();
+  s->loc = kesimo(k, s->cad);
+  if (esLocalizador(s->loc))
+    mostrar(s, "loc en la posición %d.\n", k);
+  else
+    mostrar(s, "loc quedó no válido.\n");
+}
+
+static void ejecutarLocalizadorEnCadena(TSesion s) {
+  mostrar(s, "loc%s pertenece a cad.\n",
+             localizadorEnCadena(s->loc, s->cad) ? "" : " no");
+}
+
+static void ejecutarPrecedeEnCadena(TSesion s) {
+  mostrar(s, "loc1%s precede a loc.\n",
+             precedeEnCadena(kesimo(leerNat(), s->cad), s->loc, s->cad) ? "" : " no");
+}
+
+static void ejecutarInsertarSegmentoDespues(TSesion s) {
+  TCadena sgm;
+  if (exigirLocOVacia(s) && leerCadena(s, sgm)) {
+    s->cad = insertarSegmentoDespues(sgm, s->loc, s->cad);
+    mostrar(s, "Segmento insertado después de loc.\n");
+  }
+}
+
+static void ejecutarCopiarSegmento(TSesion s) {
+  nat k1 = leerNat(), k2 = leerNat();
+  if (exigirSegmento(s, k1, k2)) {
+    TCadena sgm =
+        copiarSegmento(kesimo(k1, s->cad), kesimo(k2, s->cad), s->cad);
+    mostrarCadena(s, sgm);
+    liberarCadena(sgm);
+  }
+}
+
+static void ejecutarBorrarSegmento(TSesion s) {
+  nat k1 = leerNat(), k2 = leerNat();
+  if (exigirSegmento(s, k1, k2)) {
+    s->cad = borrarSegmento(kesimo(k1, s->cad), kesimo(k2, s->cad), s->cad);
+    mostrar(s, "Segmento borrado.\n");
+  }
+}
+
+static void ejecutarCambiarEnCadena(TSesion s) {
+  TInfo info;
+  if (exigirLoc(s) && leerInfo(s, info)) {
+    TInfo anteriorInfo = infoCadena(s->loc, s->cad);
+    s->cad = cambiarEnCadena(info, s->loc, s->cad);
+    liberarInfo(anteriorInfo);
+    mostrar(s, "Cambio.\n");
+  }
+}
+
+static void ejecutarIntercambiar(TSesion s) {
+  nat k1 = leerNat(), k2 = leerNat();
+  bool ok = exigir(s,
+                   [=] {
+                     nat n = longitud(s->cad);
+                     return (1 <= k1) && (k1 <= n) && (1 <= k2) && (k2 <= n);
+                   },
+                   "posiciones fuera de cad");
+  if (ok) {
+    s->cad = intercambiar(kesimo(k1, s->cad), kesimo(k2, s->cad), s->cad);
+    mostrar(s, "Intercambio.\n");
+  }
+}
+
+static void ejecutarSiguienteClave(TSesion s) {
+  if (exigirLocOVacia(s)) {
+    int clave = leerNat();
+    s->loc = siguienteClave(clave, s->loc, s->cad);
+    if (esLocalizador(s->loc))
+      mostrar(s, "loc avanzó buscando %d.\n", clave);
+    else
+      mostrar(s, "loc quedó no válido.\n");
+  }
+}
+
+static void ejecutarAnteriorClave(TSesion s) {
+  if (exigirLocOVacia(s)) {
+    int clave = leerNat();
+    s->loc = anteriorClave(clave, s->loc, s->cad);
+    if (esLocalizador(s->loc))
+      mostrar(s, "loc retrocedió buscando %d.\n", clave);
+    else
+      mostrar(s, "loc quedó no válido.\n");
+  }
+}
+
+static void ejecutarMenorEnCadena(TSesion s) {
+  if (exigirLoc(s)) {
+    s->loc = menorEnCadena(s->loc, s->cad);
+    mostrar(s, "El menor es %d.\n", natInfo(infoCadena(s->loc, s->cad)));
+  }
+}
+
+
+// operaciones de usoTads
+
+static void ejecutarPertenece(TSesion s) {
+  int i = leerNat();
+  mostrar(s, "%d%s pertenece a cad.\n", i, pertenece(i, s->cad) ? "" : " no");
+}
+
+static void ejecutarLongitud(TSesion s) {
+  mostrar(s, "Longitud: %u\n", longitud(s->cad));
+}
+
+static void ejecutarEstaOrdenadaPorNaturales(TSesion s) {
+  mostrar(s, "cad%s.\n",
+             estaOrdenadaPorNaturales(s->cad) ? " ordenada" : " no ordenada");
+}
+
+static void ejecutarHayNatsRepetidos(TSesion s) {
+  mostrar(s, "En cad%s.\n",
+             hayNatsRepetidos(s->cad) ? " hay naturales repetidos" :
+                   " no hay naturales repetidos");
+}
+
+static void ejecutarSonIgualesCadena(TSesion s) {
+  TCadena otra;
+  if (leerCadena(s, otra)) {
+    mostrar(s, "%s.\n",
+               sonIgualesCadena(s->cad, otra) ? "Son iguales" : "No son iguales");
+    liberarCadena(otra);
+  }
+}
+
+static void ejecutarConcatenar(TSesion s) {
+  TCadena otra;
+  if (leerCadena(s, otra)) {
+    TCadena conc = concatenar(s->cad, otra);
+    mostrarCadena(s, conc);
+    liberarCadena(conc);
+    liberarCadena(otra);
+  }
+}
+
+/*
+  Devuelve 'true' si y solo si los componentes naturales de los elementos de
+  'cad' son distintos. Es la negación de 'hayNatsRepetidos', pero ordena una
+  copia de los naturales para que la precondición de 'ordenar' se verifique
+  en O(n log n) y no en O(n^2).
+*/
+static bool sinNatsRepetidos(TCadena cad) {
+  std::vector<nat> nats;
+  for (TLocalizador loc = inicioCadena(cad); loc != NULL;
+       loc = siguienteSinVerificar(loc, cad))
+    nats.push_back(natInfo(infoCadena(loc, cad)));
+  std::sort(nats.begin(), nats.end());
+  return std::adjacent_find(nats.begin(), nats.end()) == nats.end();
+}
+
+static void ejecutarOrdenar(TSesion s) {
+  if (exigir(s, [=] { return sinNatsRepetidos(s->cad); },
+             "hay naturales repetidos en cad")) {
+    s->cad = ordenar(s->cad);
+    mostrar(s, "Quedó ordenada.\n");
+  }
+}
+
+static void ejecutarCambiarTodos(TSesion s) {
+  nat original = leerNat(), nuevo = leerNat();
+  s->cad = cambiarTodos(original, nuevo, s->cad);
+  mostrar(s, "Cambiados.\n");
+}
+
+static void ejecutarSubCadena(TSesion s) {
+  nat menor = leerNat(), mayor = leerNat();
+  bool ok = exigir(s, [=] { return estaOrdenadaPorNaturales(s->cad); },
+                   "cad no está ordenada") &&
+            exigir(s,
+                   [=] {
+                     return (menor <= mayor) && pertenece(menor, s->cad) &&
+                            pertenece(mayor, s->cad);
+                   },
+                   "los extremos no pertenecen a cad");
+  if (ok) {
+    TCadena sub = subCadena(menor, mayor, s->cad);
+    mostrarCadena(s, sub);
+    liberarCadena(sub);
+  }
+}
+
+
+// operaciones de persistencia
+
+/*
+  Los clientes de una sesión remota no pueden leer ni escribir archivos del
+  servidor.
+*/
+static bool exigirArchivos(TSesion s) {
+  return exigir(s, [=] { return !s->remota; },
+                "no se usan archivos en el servidor");
+}
+
+static void ejecutarGuardarCadena(TSesion s) {
+  char nom_archivo[MAX_LINEA];
+  leerCharsAcotado(nom_archivo, MAX_LINEA);
+  if (exigirArchivos(s)) {
+    if (guardarCadena(nom_archivo, true, s->cad))
+      mostrar(s, "Cadena guardada en %s.\n", nom_archivo);
+    else
+      mostrar(s, "No se pudo guardar la cadena.\n");
+  }
+}
+
+static void ejecutarCargarCadena(TSesion s) {
+  char nom_archivo[MAX_LINEA];
+  leerCharsAcotado(nom_archivo, MAX_LINEA);
+  if (exigirArchivos(s)) {
+    TCadena cargada = cargarCadena(nom_archivo);
+    if (cargada != NULL) {
+      liberarCadena(s->cad);
+      s->cad = cargada;
+      s->loc = inicioCadena(s->cad);
+      mostrar(s, "Cadena cargada de %s.\n", nom_archivo);
+    } else {
+      mostrar(s, "No se pudo cargar la cadena.\n");
+    }
+  }
+}
+
+static void ejecutarReiniciar(TSesion s) {
+  liberarCadena(s->cad);
+  s->cad = crearCadena();
+  s->loc = inicioCadena(s->cad);
+  mostrar(s, "Estructuras reiniciadas.\n");
+}
+
+
+// operaciones de estadisticas
+
+static void ejecutarEstadisticas(TSesion s) {
+  TBufferSalida tabla = crearBufferSalida(1024);
+  imprimirEstadisticasEnBuffer(tabla);
+  mostrar(s, "%.*s", (int)largoBufferSalida(tabla), textoBufferSalida(tabla));
+  liberarBufferSalida(tabla);
+}
+
+static void ejecutarReiniciarEstadisticas(TSesion s) {
+  reiniciarEstadisticas();
+  mostrar(s, "Estadísticas reiniciadas.\n");
+}
+
+
+struct entradaComando {
+  const char *nombre;
+  void (*ejecutar)(TSesion s);
+};
+
+// ordenada según 'strcmp'
+static constexpr entradaComando comandos[] = {
+  {"#", ejecutarComentario},
+  {"Fin", ejecutarFin},
+  {"anterior", ejecutarAnterior},
+  {"anteriorClave", ejecutarAnteriorClave},
+  {"borrarSegmento", ejecutarBorrarSegmento},
+  {"cambiarEnCadena", ejecutarCambiarEnCadena},
+  {"cambiarTodos", ejecutarCambiarTodos},
+  {"cargarCadena", ejecutarCargarCadena},
+  {"concatenar", ejecutarConcatenar},
+  {"copiarSegmento", ejecutarCopiarSegmento},
+  {"esFinalCadena", ejecutarEsFinalCadena},
+  {"esInicioCadena", ejecutarEsInicioCadena},
+  {"esLocalizador", ejecutarEsLocalizador},
+  {"esVaciaCadena", ejecutarEsVaciaCadena},
+  {"estaOrdenadaPorNaturales", ejecutarEstaOrdenadaPorNaturales},
+  {"estadisticas", ejecutarEstadisticas},
+  {"finalCadena", ejecutarFinalCadena},
+  {"guardarCadena", ejecutarGuardarCadena},
+  {"hayNatsRepetidos", ejecutarHayNatsRepetidos},
+  {"imprimirCadena", ejecutarImprimirCadena},
+  {"infoCadena", ejecutarInfoCadena},
+  {"inicioCadena", ejecutarInicioCadena},
+  {"insertarAlFinal", ejecutarInsertarAlFinal},
+  {"insertarAntes", ejecutarInsertarAntes},
+  {"insertarSegmentoDespues", ejecutarInsertarSegmentoDespues},
+  {"intercambiar", ejecutarIntercambiar},
+  {"kesimo", ejecutarKesimo},
+  {"localizadorEnCadena", ejecutarLocalizadorEnCadena},
+  {"longitud", ejecutarLongitud},
+  {"menorEnCadena", ejecutarMenorEnCadena},
+  {"ordenar", ejecutarOrdenar},
+  {"pertenece", ejecutarPertenece},
+  {"precedeEnCadena", ejecutarPrecedeEnCadena},
+  {"reiniciar", ejecutarReiniciar},
+  {"reiniciarEstadisticas", ejecutarReiniciarEstadisticas},
+  {"removerDeCadena", ejecutarRemoverDeCadena},
+  {"siguiente", ejecutarSiguiente},
+  {"siguienteClave", ejecutarSiguienteClave},
+  {"sonIgualesCadena", ejecutarSonIgualesCadena},
+  {"subCadena", ejecutarSubCadena},
+};
+
+static constexpr nat CANT_COMANDOS = sizeof(comandos) / sizeof(comandos[0]);
+
+/*
+  Como 'strcmp', pero evaluable en tiempo de compilación.
+*/
+static constexpr int compararNombres(const char *a, const char *b) {
+  while ((*a != '\0') && (*a == *b)) {
+    a++;
+    b++;
+  }
+  return (unsigned char)*a - (unsigned char)*b;
+}
+
+static constexpr bool tablaOrdenada() {
+  bool res = true;
+  for (nat i = 1; res && (i < CANT_COMANDOS); i++)
+    res = compararNombres(comandos[i - 1].nombre, comandos[i].nombre) < 0;
+  return res;
+}
+
+static_assert(tablaOrdenada(),
+              "la tabla de comandos debe estar ordenada y sin repetidos");
+
+// Índice de dispersión perfecta sobre 'comandos': con la semilla elegida al
+// compilar, cada nombre cae en una ranura distinta, por lo que encontrar un
+// comando cuesta calcular la dispersión y una sola comparación.
+static constexpr nat TAM_INDICE = 512;
+
+struct indiceComandos {
+  unsigned semilla;
+  unsigned char ranuras[TAM_INDICE]; // posición en 'comandos' o 0 si vacía
+};
+
+/*
+  Dispersión FNV-1a de 'nombre' a partir de 'semilla'.
+*/
+static constexpr unsigned dispersion(const char *nombre, unsigned semilla) {
+  unsigned h = semilla;
+  while (*nombre != '\0') {
+    h = (h ^ (unsigned char)*nombre) * 16777619u;
+    nombre++;
+  }
+  return h % TAM_INDICE;
+}
+
+/*
+  Busca la primera semilla sin colisiones y devuelve el índice armado con ella.
+*/
+static constexpr indiceComandos armarIndice() {
+  indiceComandos res = {2166136261u, {}};
+  bool colision = true;
+  while (colision) {
+    for (nat i = 0; i < TAM_INDICE; i++)
+      res.ranuras[i] = 0;
+    colision = false;
+    for (nat k = 1; !colision && (k <= CANT_COMANDOS); k++) {
+      unsigned h = dispersion(comandos[k - 1].nombre, res.semilla);
+      colision = (res.ranuras[h] != 0);
+      res.ranuras[h] = k;
+    }
+    if (colision)
+      res.semilla++;
+  }
+  return res;
+}
+
+static_assert(CANT_COMANDOS < 256, "las ranuras del índice son de un byte");
+static constexpr indiceComandos indice = armarIndice();
+
+nat cantidadComandos() { return CANT_COMANDOS; }
+
+const char *nombreComando(nat k) {
+  assert((1 <= k) && (k <= CANT_COMANDOS));
+  return comandos[k - 1].nombre;
+}
+
+nat buscarComando(const char *nombre) {
+  nat k = indice.ranuras[dispersion(nombre, indice.semilla)];
+  if ((k != 0) && strcmp(nombre, comandos[k - 1].nombre))
+    k = 0;
+  return k;
+}
+
+static TSesion nuevaSesion(TBufferSalida buf, bool remota) {
+  TSesion s = new repSesion;
+  s->cad = crearCadena();
+  s->loc = inicioCadena(s->cad); // no válido porque cad es vacía
+  s->salida = buf;
+  s->terminada = false;
+  s->remota = remota;
+  return s;
+}
+
+TSesion crearSesion() { return nuevaSesion(NULL, false); }
+
+TSesion crearSesionRemota(TBufferSalida buf) { return nuevaSesion(buf, true); }
+
+void liberarSesion(TSesion s) {
+  liberarCadena(s->cad);
+  delete s;
+}
+
+bool terminoSesion(TSesion s) { return s->terminada; }
+
+void ejecutarComando(const char *nombre, TSesion s) {
+  nat k = buscarComando(nombre);
+  if (k != 0)
+    comandos[k - 1].ejecutar(s);
+  else
+    mostrar(s, "Comando no reconocido.\n");
+}
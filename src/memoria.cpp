@@ -0,0 +1,118 @@
+/*
+  Módulo de implementación de 'memoria'.
+
+  Las reservas vivas se guardan en una tabla de dispersión indexada por
+  dirección, protegida por un cerrojo porque en el modo servidor reservan y
+  liberan varios hilos. El informe se hace con 'atexit', registrado en la
+  primera reserva.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/memoria.h"
+
+#ifdef CONTROL_MEMORIA
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+static const char *nombres[CANT_TIPOS_MEMORIA] = {"nodo", "TInfo",
+                                                  "texto de TInfo", "índice"};
+
+struct reserva {
+  TTipoMemoria tipo;
+  size_t bytes;
+  TLugar lugar;
+};
+
+// Clave con la que se agrupan los problemas en el informe.
+struct clave {
+  TTipoMemoria tipo;
+  TLugar lugar;
+
+  bool operator<(const clave &otra) const {
+    if (tipo != otra.tipo)
+      return tipo < otra.tipo;
+    int cmp = strcmp(lugar.archivo, otra.lugar.archivo);
+    return (cmp != 0) ? (cmp < 0) : (lugar.linea < otra.lugar.linea);
+  }
+};
+
+struct acumulado {
+  nat cantidad;
+  size_t bytes;
+};
+
+struct estadoMemoria {
+  std::mutex cerrojo;
+  std::unordered_map<const void *, reserva> vivas;
+  std::map<clave, acumulado> invalidas;
+  bool informeRegistrado = false;
+};
+
+static estadoMemoria &estado() {
+  static estadoMemoria res;
+  return res;
+}
+
+/*
+  Imprime en la salida de errores las reservas vivas y las liberaciones
+  inválidas, si las hay.
+*/
+static void informar() {
+  estadoMemoria &e = estado();
+  std::lock_guard<std::mutex> guardia(e.cerrojo);
+  std::map<clave, acumulado> perdidas;
+  for (const auto &v : e.vivas) {
+    acumulado &a = perdidas[clave{v.second.tipo, v.second.lugar}];
+    a.cantidad++;
+    a.bytes += v.second.bytes;
+  }
+  if (!perdidas.empty()) {
+    fprintf(stderr, "---- Memoria no liberada ----\n");
+    for (const auto &p : perdidas)
+      fprintf(stderr, "%s: %u (%zu bytes) reservados en %s:%u.\n",
+              nombres[p.first.tipo], p.second.cantidad, p.second.bytes,
+              p.first.lugar.archivo, p.first.lugar.linea);
+  }
+  if (!e.invalidas.empty()) {
+    fprintf(stderr, "---- Liberaciones inválidas ----\n");
+    for (const auto &p : e.invalidas)
+      fprintf(stderr, "%s: %u liberados en %s:%u.\n", nombres[p.first.tipo],
+              p.second.cantidad, p.first.lugar.archivo, p.first.lugar.linea);
+  }
+}
+
+void registrarReserva(const void *p, size_t bytes, TTipoMemoria tipo,
+                      TLugar lugar) {
+  estadoMemoria &e = estado();
+  std::lock_guard<std::mutex> guardia(e.cerrojo);
+  if (!e.informeRegistrado) {
+    atexit(informar);
+    e.informeRegistrado = true;
+  }
+  e.vivas[p] = reserva{tipo, bytes, lugar};
+}
+
+bool registrarLiberacion(const void *p, TTipoMemoria tipo, TLugar lugar) {
+  bool res = true;
+  if (p != NULL) {
+    estadoMemoria &e = estado();
+    std::lock_guard<std::mutex> guardia(e.cerrojo);
+    auto it = e.vivas.find(p);
+    res = (it != e.vivas.end()) && (it->second.tipo == tipo);
+    if (res)
+      e.vivas.erase(it);
+    else
+      e.invalidas[clave{tipo, lugar}].cantidad++;
+  }
+  return res;
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+  Módulo de implementación de 'persistencia'.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/persistencia.h"
+#include "../include/cadena.h"
+#include "../include/info.h"
+#include "../include/salida.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+#include <fcntl.h>    // open
+#include <stdint.h>
+#include <stdio.h>    // fopen, fwrite, fseek
+#include <stdlib.h>
+#include <string.h>   // memcpy, memcmp
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+#include <algorithm> // sort
+#include <vector>
+
+#define MARCA_ARCHIVO "CADB"
+#define BANDERA_INDICE 1u
+#define TAM_REGISTRO 12
+#define TAM_TAMPON (1 << 16)
+
+struct cabezalArchivo {
+  char marca[4];
+  uint32_t version;
+  uint32_t banderas;
+  uint32_t reservado;
+  uint64_t cantidad;
+  uint64_t desplazamientoIndice;
+};
+
+struct repCadenaMapeada {
+  const char *base;
+  size_t tamano;
+  nat cantidad;
+  const char *registros;
+  const uint32_t *indice; // NULL si el archivo no tiene índice
+};
+
+/*
+  Escribe 'largo' bytes de 'datos' en 'f' a través de 'tampon', que tiene
+  'usados' bytes ocupados. Devuelve 'false' si falla una escritura.
+*/
+static bool escribir(const void *datos, size_t largo, char *tampon,
+                     size_t &usados, FILE *f) {
+  bool ok = true;
+  if (usados + largo > TAM_TAMPON) {
+    ok = (fwrite(tampon, 1, usados, f) == usados);
+    usados = 0;
+  }
+  memcpy(tampon + usados, datos, largo);
+  usados += largo;
+  return ok;
+}
+
+/*
+  Llena 'cab' para un archivo con 'cantidad' elementos.
+*/
+static void llenarCabezal(nat cantidad, bool conIndice, cabezalArchivo &cab) {
+  memcpy(cab.marca, MARCA_ARCHIVO, 4);
+  cab.version = VERSION_ARCHIVO_CADENA;
+  cab.banderas = conIndice ? BANDERA_INDICE : 0;
+  cab.reservado = 0;
+  cab.cantidad = cantidad;
+  cab.desplazamientoIndice =
+      conIndice ? sizeof(cabezalArchivo) + (uint64_t)cantidad * TAM_REGISTRO
+                : 0;
+}
+
+bool guardarCadena(const char *archivo, bool conIndice, TCadena cad) {
+  FILE *f = fopen(archivo, "wb");
+  if (f == NULL)
+    return false;
+
+  // la cantidad se conoce al terminar de recorrer 'cad', por lo que el
+  // cabezal se escribe al principio para reservar su lugar y se reescribe
+  // al final
+  cabezalArchivo cab;
+  llenarCabezal(0, conIndice, cab);
+  char *tampon = new char[TAM_TAMPON];
+  size_t usados = 0;
+  bool ok = escribir(&cab, sizeof(cab), tampon, usados, f);
+
+  // pares (natural, posición) para construir el índice
+  std::vector<uint64_t> claves;
+  nat cantidad = 0;
+  for (TLocalizador loc = inicioCadena(cad); ok && (loc != NULL);
+       loc = siguienteSinVerificar(loc, cad)) {
+    TInfo info = infoCadena(loc, cad);
+    uint32_t n = natInfo(info);
+    double r = realInfo(info);
+    char registro[TAM_REGISTRO];
+    memcpy(registro, &n, 4);
+    memcpy(registro + 4, &r, 8);
+    ok = escribir(registro, TAM_REGISTRO, tampon, usados, f);
+    if (conIndice)
+      claves.push_back(((uint64_t)n << 32) | cantidad);
+    cantidad++;
+  }
+
+  if (ok && conIndice) {
+    std::sort(claves.begin(), claves.end());
+    for (nat i = 0; ok && (i < cantidad); i++) {
+      uint32_t p = (uint32_t)claves[i];
+      ok = escribir(&p, 4, tampon, usados, f);
+    }
+  }
+  if (ok)
+    ok = (fwrite(tampon, 1, usados, f) == usados);
+  if (ok) {
+    llenarCabezal(cantidad, conIndice, cab);
+    ok = (fseek(f, 0, SEEK_SET) == 0) &&
+         (fwrite(&cab, sizeof(cab), 1, f) == 1);
+  }
+  ok = (fclose(f) == 0) && ok;
+
+  delete[] tampon;
+  return ok;
+}
+
+TCadenaMapeada abrirCadenaMapeada(const char *archivo) {
+  int fd = open(archivo, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+
+  TCadenaMapeada res = NULL;
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(cabezalArchivo))) {
+    size_t tamano = st.st_size;
+    void *base = mmap(NULL, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base != MAP_FAILED) {
+      cabezalArchivo cab;
+      memcpy(&cab, base, sizeof(cab));
+      // los límites se comparan sin sumar ni multiplicar valores leídos del
+      // archivo, que podrían desbordar
+      bool valido = (memcmp(cab.marca, MARCA_ARCHIVO, 4) == 0) &&
+                    (cab.version == VERSION_ARCHIVO_CADENA) &&
+                    (cab.cantidad <= UINT32_MAX) &&
+                    (cab.cantidad <=
+                     (tamano - sizeof(cabezalArchivo)) / TAM_REGISTRO);
+      if (valido && (cab.banderas & BANDERA_INDICE)) {
+        uint64_t finRegistros =
+            sizeof(cabezalArchivo) + cab.cantidad * TAM_REGISTRO;
+        valido = (cab.desplazamientoIndice % 4 == 0) &&
+                 (cab.desplazamientoIndice >= finRegistros) &&
+                 (cab.desplazamientoIndice <= tamano) &&
+                 (cab.cantidad <= (tamano - cab.desplazamientoIndice) / 4);
+      }
+      if (valido) {
+        madvise(base, tamano, MADV_SEQUENTIAL);
+        res = new repCadenaMapeada;
+        res->base = (const char *)base;
+        res->tamano = tamano;
+        res->cantidad = (nat)cab.cantidad;
+        res->registros = res->base + sizeof(cabezalArchivo);
+        res->indice =
+            (cab.banderas & BANDERA_INDICE)
+                ? (const uint32_t *)(res->base + cab.desplazamientoIndice)
+                : NULL;
+      } else {
+        munmap(base, tamano);
+      }
+    }
+  }
+  close(fd);
+  return res;
+}
+
+void cerrarCadenaMapeada(TCadenaMapeada map) {
+  munmap((void *)map->base, map->tamano);
+  delete map;
+}
+
+nat longitudMapeada(TCadenaMapeada map) { return map->cantidad; }
+
+nat natMapeado(nat k, TCadenaMapeada map) {
+  assert((1 <= k) && (k <= map->cantidad));
+  uint32_t n;
+  memcpy(&n, map->registros + (size_t)(k - 1) * TAM_REGISTRO, 4);
+  return n;
+}
+
+double realMapeado(nat k, TCadenaMapeada map) {
+  assert((1 <= k) && (k <= map->cantidad));
+  double r;
+  memcpy(&r, map->registros + (size_t)(k - 1) * TAM_REGISTRO + 4, 8);
+  return r;
+}
+
+/*
+  Devuelve la posición (base 1) del elemento de 'map' que indica la entrada
+  'i' del índice, o 0 si la entrada está fuera de rango.
+  Las entradas se validan al usarlas y no al abrir el archivo, para que
+  abrirlo siga siendo O(1).
+*/
+static nat posicionIndice(nat i, TCadenaMapeada map) {
+  uint32_t p = map->indice[i];
+  return (p < map->cantidad) ? p + 1 : 0;
+}
+
+nat buscarClaveMapeada(nat clave, TCadenaMapeada map) {
+  nat res = 0;
+  if (map->indice != NULL) {
+    // primera posición del índice cuyo natural no es menor que 'clave'
+    nat izq = 0, der = map->cantidad;
+    bool danado = false;
+    while (!danado && (izq < der)) {
+      nat medio = izq + (der - izq) / 2;
+      nat k = posicionIndice(medio, map);
+      if (k == 0)
+        danado = true;
+      else if (natMapeado(k, map) < clave)
+        izq = medio + 1;
+      else
+        der = medio;
+    }
+    if (!danado && (izq < map->cantidad)) {
+      nat k = posicionIndice(izq, map);
+      if ((k != 0) && (natMapeado(k, map) == clave))
+        res = k;
+    }
+  } else {
+    nat k = 1;
+    while ((k <= map->cantidad) && (natMapeado(k, map) != clave))
+      k++;
+    if (k <= map->cantidad)
+      res = k;
+  }
+  return res;
+}
+
+// buffer reutilizado por 'imprimirCadenaMapeada'
+static thread_local TBufferSalida impresion = NULL;
+
+/*
+  Escribe el contenido de 'impresion' en la salida estándar y lo deja vacío.
+*/
+static void volcarImpresion() {
+  fwrite(textoBufferSalida(impresion), 1, largoBufferSalida(impresion), stdout);
+  vaciarBufferSalida(impresion);
+}
+
+void imprimirCadenaMapeada(TCadenaMapeada map) {
+  if (impresion == NULL)
+    impresion = crearBufferSalida(2 * TAM_TAMPON);
+  for (nat k = 1; k <= map->cantidad; k++) {
+    agregarCaracter('(', impresion);
+    // como con "%i", el natural se muestra con signo
+    agregarEntero((int)natMapeado(k, map), impresion);
+    agregarCaracter(',', impresion);
+    agregarReal2(realMapeado(k, map), impresion);
+    agregarCaracter(')', impresion);
+    if (largoBufferSalida(impresion) >= TAM_TAMPON)
+      volcarImpresion();
+  }
+  agregarCaracter('\n', impresion);
+  volcarImpresion();
+}
+
+/*
+  No se usa el índice del archivo: la cadena cargada debe tener los elementos
+  en el orden en que se guardaron, que es el de los registros, y agregar cada
+  uno al final es O(1).
+*/
+TCadena cargarCadena(const char *archivo) {
+  TCadena res = NULL;
+  TCadenaMapeada map = abrirCadenaMapeada(archivo);
+  if (map != NULL) {
+    res = crearCadena();
+    for (nat k = 1; k <= map->cantidad; k++)
+      res = insertarAlFinal(crearInfo(natMapeado(k, map), realMapeado(k, map)),
+                            res);
+    cerrarCadenaMapeada(map);
+  }
+  return res;
+}
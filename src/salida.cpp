@@ -0,0 +1,135 @@
+/*
+  Módulo de implementación de 'salida'.
+
+  Los números se formatean con 'to_chars', que no interpreta formatos ni toma
+  el cerrojo de 'stdio', y produce los mismos caracteres que 'printf'.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/salida.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>  // vsnprintf
+#include <string.h> // memcpy
+#include <unistd.h> // write
+
+#include <charconv> // to_chars
+
+// Lugar suficiente para cualquier número formateado por este módulo.
+#define MAX_NUMERO 352
+
+struct repBufferSalida {
+  char *datos;
+  nat largo;
+  nat capacidad; // sin contar el '\0' final
+};
+
+TBufferSalida crearBufferSalida(nat capacidad) {
+  assert(capacidad > 0);
+  TBufferSalida res = new repBufferSalida;
+  res->datos = new char[capacidad + 1];
+  res->datos[0] = '\0';
+  res->largo = 0;
+  res->capacidad = capacidad;
+  return res;
+}
+
+void liberarBufferSalida(TBufferSalida buf) {
+  delete[] buf->datos;
+  delete buf;
+}
+
+nat largoBufferSalida(TBufferSalida buf) { return buf->largo; }
+
+const char *textoBufferSalida(TBufferSalida buf) {
+  buf->datos[buf->largo] = '\0';
+  return buf->datos;
+}
+
+void vaciarBufferSalida(TBufferSalida buf) { buf->largo = 0; }
+
+/*
+  Se asegura de que en 'buf' entren 'extra' caracteres más.
+*/
+static void reservar(nat extra, TBufferSalida buf) {
+  if (buf->largo + extra > buf->capacidad) {
+    nat nueva = buf->capacidad * 2;
+    if (nueva < buf->largo + extra)
+      nueva = buf->largo + extra;
+    char *datos = new char[nueva + 1];
+    memcpy(datos, buf->datos, buf->largo);
+    delete[] buf->datos;
+    buf->datos = datos;
+    buf->capacidad = nueva;
+  }
+}
+
+void agregarCaracter(char c, TBufferSalida buf) {
+  reservar(1, buf);
+  buf->datos[buf->largo++] = c;
+}
+
+void agregarChars(const char *cs, nat largo, TBufferSalida buf) {
+  reservar(largo, buf);
+  memcpy(buf->datos + buf->largo, cs, largo);
+  buf->largo += largo;
+}
+
+void agregarEntero(int n, TBufferSalida buf) {
+  reservar(MAX_NUMERO, buf);
+  char *ini = buf->datos + buf->largo;
+  std::to_chars_result r = std::to_chars(ini, ini + MAX_NUMERO, n);
+  buf->largo += r.ptr - ini;
+}
+
+void agregarReal2(double r, TBufferSalida buf) {
+  reservar(MAX_NUMERO, buf);
+  char *ini = buf->datos + buf->largo;
+  std::to_chars_result res =
+      std::to_chars(ini, ini + MAX_NUMERO, r, std::chars_format::fixed, 2);
+  buf->largo += res.ptr - ini;
+}
+
+void agregarFormato(TBufferSalida buf, const char *formato, ...) {
+  va_list args;
+  va_start(args, formato);
+  agregarFormatoV(buf, formato, args);
+  va_end(args);
+}
+
+void agregarFormatoV(TBufferSalida buf, const char *formato, va_list args) {
+  va_list copia;
+  va_copy(copia, args);
+  int largo = vsnprintf(buf->datos + buf->largo,
+                        buf->capacidad - buf->largo + 1, formato, copia);
+  va_end(copia);
+  if ((largo > 0) && (buf->largo + largo > buf->capacidad)) {
+    // no entró: se hace lugar y se vuelve a formatear
+    reservar(largo, buf);
+    vsnprintf(buf->datos + buf->largo, largo + 1, formato, args);
+  }
+  if (largo > 0)
+    buf->largo += largo;
+}
+
+bool volcarBufferSalida(int fd, TBufferSalida buf) {
+  const char *p = buf->datos;
+  nat pendientes = buf->largo;
+  bool ok = true;
+  while (ok && (pendientes > 0)) {
+    ssize_t escritos = write(fd, p, pendientes);
+    if (escritos > 0) {
+      p += escritos;
+      pendientes -= escritos;
+    } else {
+      ok = (escritos < 0) && (errno == EINTR);
+    }
+  }
+  buf->largo = 0;
+  return ok;
+}
@@ -0,0 +1,384 @@
+/*
+  Módulo de implementación de 'servidor'.
+
+  Los sockets de los clientes se registran en 'epoll' con EPOLLONESHOT: cuando
+  uno tiene eventos se deja de vigilar y se encola para los trabajadores, y el
+  trabajador que lo atiende lo vuelve a registrar al terminar. Así cada
+  'TSesion' es usada por un solo hilo a la vez.
+
+  Los comandos se ejecutan por líneas completas: lo recibido hasta el último
+  cambio de línea se lee con un 'TLector' de memoria y lo que sigue queda
+  pendiente hasta que llegue el resto. Cada vez que se atiende una conexión
+  se ejecutan a lo sumo MAX_LINEAS líneas; si quedan más, la conexión vuelve
+  al final de la cola sin recibir nada nuevo, para que un cliente con muchos
+  comandos no demore a los demás.
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/servidor.h"
+#include "../include/interprete.h"
+#include "../include/salida.h"
+#include "../include/utils.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#define MAX_PALABRA 32
+#define MAX_EVENTOS 64
+#define TAM_RECEPCION (1 << 16)
+// Tamaño a partir del cual una línea sin terminar hace cerrar la conexión.
+#define MAX_PENDIENTE (1 << 26)
+// Salida sin enviar a partir de la cual se deja de leer al cliente.
+#define MAX_ATRASO (1 << 20)
+// Cantidad máxima de líneas que se ejecutan cada vez que se atiende una
+// conexión.
+#define MAX_LINEAS 64
+
+// Marcas de los descriptores que no son conexiones en los eventos de 'epoll'.
+#define MARCA_ESCUCHA 1
+#define MARCA_SENAL 2
+
+struct conexion {
+  int fd;
+  TSesion sesion;
+  TBufferSalida salida;
+  nat enviados; // caracteres de 'salida' ya enviados
+  char *pendiente; // recibido y todavía no ejecutado
+  nat inicio; // caracteres de 'pendiente' ya ejecutados (ver 'atender')
+  nat largo;
+  nat capacidad;
+  bool cerrar; // el cliente cerró su extremo o ejecutó 'Fin'
+};
+
+struct servidor {
+  int ep;
+  std::mutex cerrojo;
+  std::condition_variable hayTrabajo;
+  std::deque<conexion *> listas;
+  std::unordered_set<conexion *> abiertas;
+  bool terminar;
+};
+
+static conexion *crearConexion(int fd) {
+  conexion *c = new conexion;
+  c->fd = fd;
+  c->salida = crearBufferSalida(TAM_RECEPCION);
+  c->sesion = crearSesionRemota(c->salida);
+  c->enviados = 0;
+  c->capacidad = TAM_RECEPCION;
+  c->pendiente = new char[c->capacidad];
+  c->inicio = 0;
+  c->largo = 0;
+  c->cerrar = false;
+  return c;
+}
+
+static void liberarConexion(conexion *c) {
+  close(c->fd);
+  liberarSesion(c->sesion);
+  liberarBufferSalida(c->salida);
+  delete[] c->pendiente;
+  delete c;
+}
+
+/*
+  Vuelve a registrar 'c' en 'epoll' para que se avise cuando esté lista.
+*/
+static void rearmar(conexion *c, bool leer, bool escribir, servidor &srv) {
+  epoll_event ev;
+  ev.events = EPOLLONESHOT | (leer ? EPOLLIN : 0) | (escribir ? EPOLLOUT : 0);
+  ev.data.ptr = c;
+  epoll_ctl(srv.ep, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+static void cerrarConexion(conexion *c, servidor &srv) {
+  epoll_ctl(srv.ep, EPOLL_CTL_DEL, c->fd, NULL);
+  {
+    std::lock_guard<std::mutex> guardia(srv.cerrojo);
+    srv.abiertas.erase(c);
+  }
+  liberarConexion(c);
+}
+
+/*
+  Envía lo que se pueda de la salida de 'c'. Devuelve 'false' si el cliente
+  ya no puede recibir.
+*/
+static bool enviar(conexion *c) {
+  bool ok = true;
+  nat total = largoBufferSalida(c->salida);
+  const char *datos = textoBufferSalida(c->salida);
+  bool bloqueado = false;
+  while (ok && !bloqueado && (c->enviados < total)) {
+    ssize_t n =
+        send(c->fd, datos + c->enviados, total - c->enviados, MSG_NOSIGNAL);
+    if (n > 0)
+      c->enviados += n;
+    else if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+      bloqueado = true;
+    else if (!((n < 0) && (errno == EINTR)))
+      ok = false;
+  }
+  if (c->enviados == total) {
+    vaciarBufferSalida(c->salida);
+    c->enviados = 0;
+  }
+  return ok;
+}
+
+/*
+  Agrega a lo pendiente de 'c' todo lo que el cliente haya enviado.
+  Devuelve 'false' si hubo un error o la línea pendiente es demasiado larga.
+*/
+static bool recibir(conexion *c) {
+  bool ok = true;
+  bool bloqueado = false;
+  while (ok && !bloqueado && !c->cerrar) {
+    if (c->largo == c->capacidad) {
+      ok = (c->capacidad < MAX_PENDIENTE);
+      if (ok) {
+        char *nuevo = new char[2 * c->capacidad];
+        memcpy(nuevo, c->pendiente, c->largo);
+        delete[] c->pendiente;
+        c->pendiente = nuevo;
+        c->capacidad *= 2;
+      }
+    }
+    if (ok) {
+      ssize_t n =
+          recv(c->fd, c->pendiente + c->largo, c->capacidad - c->largo, 0);
+      if (n > 0)
+        c->largo += n;
+      else if (n == 0)
+        c->cerrar = true;
+      else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        bloqueado = true;
+      else if (errno != EINTR)
+        ok = false;
+    }
+  }
+  return ok;
+}
+
+/*
+  Ejecuta hasta MAX_LINEAS líneas completas pendientes de 'c' (y también la
+  última, sin terminar, si el cliente ya cerró su extremo). Devuelve 'true'
+  si quedan líneas para ejecutar; en ese caso deja 'c->inicio' al comienzo
+  de la primera, y si no mueve lo pendiente al principio de 'c->pendiente'.
+*/
+static bool ejecutarPendiente(conexion *c) {
+  nat hasta = c->inicio, lineas = 0;
+  for (nat i = c->inicio; (i < c->largo) && (lineas < MAX_LINEAS); i++) {
+    if (c->pendiente[i] == '\n') {
+      hasta = i + 1;
+      lineas++;
+    }
+  }
+  if (c->cerrar && (lineas < MAX_LINEAS))
+    hasta = c->largo;
+  if (hasta > c->inicio) {
+    TLector lector =
+        crearLectorMemoria(c->pendiente + c->inicio, hasta - c->inicio);
+    fijarLectorActual(lector);
+    char nom_comando[MAX_PALABRA];
+    while (!terminoSesion(c->sesion) && !finEntrada()) {
+      leerCharsAcotado(nom_comando, MAX_PALABRA);
+      ejecutarComando(nom_comando, c->sesion);
+      descartarRestoLinea();
+    }
+    fijarLectorActual(NULL);
+    liberarLector(lector);
+    c->inicio = hasta;
+    if (terminoSesion(c->sesion))
+      c->cerrar = true;
+  }
+
+  bool quedan = !terminoSesion(c->sesion) && (c->inicio < c->largo) &&
+                (c->cerrar || (memchr(c->pendiente + c->inicio, '\n',
+                                      c->largo - c->inicio) != NULL));
+  if (!quedan) {
+    memmove(c->pendiente, c->pendiente + c->inicio, c->largo - c->inicio);
+    c->largo -= c->inicio;
+    c->inicio = 0;
+  }
+  return quedan;
+}
+
+/*
+  Pone 'c' al final de la cola de conexiones para atender. Sigue sin estar
+  registrada en 'epoll', por lo que ningún otro hilo la usa mientras espera.
+*/
+static void reencolar(conexion *c, servidor &srv) {
+  std::lock_guard<std::mutex> guardia(srv.cerrojo);
+  srv.listas.push_back(c);
+  srv.hayTrabajo.notify_one();
+}
+
+/*
+  Si 'c->inicio' no es 0 quedaron líneas sin ejecutar la vez anterior y se
+  siguen ejecutando sin recibir más.
+*/
+static void atender(conexion *c, servidor &srv) {
+  bool ok = enviar(c);
+  bool atrasada = largoBufferSalida(c->salida) - c->enviados > MAX_ATRASO;
+  bool quedan = false;
+  if (ok && !atrasada && !terminoSesion(c->sesion)) {
+    if (!c->cerrar && (c->inicio == 0))
+      ok = recibir(c);
+    if (ok) {
+      quedan = ejecutarPendiente(c);
+      ok = enviar(c);
+    }
+  }
+  bool sinEnviar = largoBufferSalida(c->salida) > c->enviados;
+  if (!ok || (c->cerrar && !sinEnviar && !quedan))
+    cerrarConexion(c, srv);
+  else if (quedan)
+    reencolar(c, srv);
+  else
+    rearmar(c, !c->cerrar && !atrasada, sinEnviar, srv);
+}
+
+static void trabajar(servidor &srv) {
+  bool seguir = true;
+  while (seguir) {
+    conexion *c = NULL;
+    {
+      std::unique_lock<std::mutex> guardia(srv.cerrojo);
+      srv.hayTrabajo.wait(guardia,
+                          [&] { return srv.terminar || !srv.listas.empty(); });
+      if (srv.terminar) {
+        seguir = false;
+      } else {
+        c = srv.listas.front();
+        srv.listas.pop_front();
+      }
+    }
+    if (c != NULL)
+      atender(c, srv);
+  }
+}
+
+/*
+  Acepta todas las conexiones que estén esperando en 'escucha'.
+*/
+static void aceptar(int escucha, servidor &srv) {
+  int fd;
+  while ((fd = accept4(escucha, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >=
+         0) {
+    conexion *c = crearConexion(fd);
+    {
+      std::lock_guard<std::mutex> guardia(srv.cerrojo);
+      srv.abiertas.insert(c);
+    }
+    epoll_event ev;
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = c;
+    epoll_ctl(srv.ep, EPOLL_CTL_ADD, fd, &ev);
+  }
+}
+
+/*
+  Crea el socket 'ruta' y lo pone a escuchar. Devuelve su descriptor o -1.
+*/
+static int escucharEn(const char *ruta) {
+  sockaddr_un dir;
+  if (strlen(ruta) >= sizeof(dir.sun_path))
+    return -1;
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd >= 0) {
+    memset(&dir, 0, sizeof(dir));
+    dir.sun_family = AF_UNIX;
+    strcpy(dir.sun_path, ruta);
+    unlink(ruta);
+    if ((bind(fd, (sockaddr *)&dir, sizeof(dir)) < 0) ||
+        (listen(fd, SOMAXCONN) < 0)) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  return fd;
+}
+
+int ejecutarServidor(const char *ruta, nat hilos) {
+  assert((hilos > 0) && (hilos <= MAX_HILOS));
+  // las señales de terminación se reciben por 'signalfd'; se bloquean antes
+  // de crear los trabajadores para que ellos también las tengan bloqueadas
+  sigset_t senales;
+  sigemptyset(&senales);
+  sigaddset(&senales, SIGINT);
+  sigaddset(&senales, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &senales, NULL);
+
+  int escucha = escucharEn(ruta);
+  if (escucha < 0) {
+    fprintf(stderr, "No se pudo escuchar en %s: %s.\n", ruta, strerror(errno));
+    return 1;
+  }
+  int sfd = signalfd(-1, &senales, SFD_NONBLOCK | SFD_CLOEXEC);
+
+  servidor srv;
+  srv.ep = epoll_create1(EPOLL_CLOEXEC);
+  srv.terminar = false;
+  epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = MARCA_ESCUCHA;
+  epoll_ctl(srv.ep, EPOLL_CTL_ADD, escucha, &ev);
+  ev.data.u64 = MARCA_SENAL;
+  epoll_ctl(srv.ep, EPOLL_CTL_ADD, sfd, &ev);
+
+  std::vector<std::thread> trabajadores;
+  for (nat i = 0; i < hilos; i++)
+    trabajadores.push_back(std::thread(trabajar, std::ref(srv)));
+
+  fprintf(stderr, "Escuchando en %s con %u hilos.\n", ruta, hilos);
+  bool terminar = false;
+  while (!terminar) {
+    epoll_event eventos[MAX_EVENTOS];
+    int n = epoll_wait(srv.ep, eventos, MAX_EVENTOS, -1);
+    for (int i = 0; i < n; i++) {
+      if (eventos[i].data.u64 == MARCA_ESCUCHA) {
+        aceptar(escucha, srv);
+      } else if (eventos[i].data.u64 == MARCA_SENAL) {
+        terminar = true;
+      } else {
+        std::lock_guard<std::mutex> guardia(srv.cerrojo);
+        srv.listas.push_back((conexion *)eventos[i].data.ptr);
+        srv.hayTrabajo.notify_one();
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guardia(srv.cerrojo);
+    srv.terminar = true;
+    srv.hayTrabajo.notify_all();
+  }
+  for (std::thread &t : trabajadores)
+    t.join();
+  for (conexion *c : srv.abiertas)
+    liberarConexion(c);
+
+  close(srv.ep);
+  close(sfd);
+  close(escucha);
+  unlink(ruta);
+  return 0;
+}
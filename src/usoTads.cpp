@@ -2,11 +2,21 @@
 #include "../include/utils.h"
 #include "../include/info.h"
 #include "../include/usoTads.h"
+#include "../include/epocas.h"
+#include "../include/estadisticas.h"
 
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+/*
+  Libera el 'TInfo' 'elem'.
+  Se usa como 'TLiberador' de los elementos sustituidos en una cadena.
+*/
+static void liberarInfoRetirada(void *elem, void *contexto) {
+  liberarInfo((TInfo)elem);
+}
+
 /*
   Devuelve 'true' si y solo si en 'cad' hay un elemento cuyo campo natural es
   'elem'.
@@ -14,8 +24,16 @@
   elementos de 'cad'.
 */
 bool pertenece(nat elem, TCadena cad) {
+  contarLlamada(opPertenece);
+  nat recorridos = 0;
+  entrarLectura();
   TLocalizador x = inicioCadena(cad);
-  x = siguienteClave(elem, x, cad);
+  while ((x != NULL) && (natInfo(infoCadena(x, cad)) != elem)) {
+    x = siguienteSinVerificar(x, cad);
+    recorridos++;
+  }
+  salirLectura();
+  contarNodos(opPertenece, recorridos);
   return (x != NULL);
 }
   /*x = cad->inicio;
@@ -31,15 +49,17 @@ bool pertenece(nat elem, TCadena cad) {
   elementos de 'cad'.
 */
 nat longitud(TCadena cad) {
+  contarLlamada(opLongitud);
   TLocalizador c = NULL;
   nat aux = 0;
+  entrarLectura();
   c = inicioCadena(cad);
-  if (!esVaciaCadena(cad)) {
-    while (c != NULL) {
-      c = siguiente(c, cad);
-      aux = aux + 1;
-    }
+  while (c != NULL) {
+    c = siguienteSinVerificar(c, cad);
+    aux = aux + 1;
   }
+  salirLectura();
+  contarNodos(opLongitud, aux);
   return aux;
 }
 
@@ -51,6 +71,7 @@ nat longitud(TCadena cad) {
   elementos de 'cad'.
 */
 bool estaOrdenadaPorNaturales(TCadena cad)  {
+  contarLlamada(opEstaOrdenadaPorNaturales);
   bool res;
   if (esVaciaCadena(cad)) {
     res = true;
@@ -62,6 +83,7 @@ bool estaOrdenadaPorNaturales(TCadena cad)  {
     while ((d != nullptr) && (natInfo(infoCadena(d, cad)) >= natInfo(infoCadena(c, cad)))) {
       c = siguiente(c, cad);
       d = siguiente(d, cad);
+      contarNodos(opEstaOrdenadaPorNaturales, 1);
     }
     res = (d == nullptr);
   }
@@ -71,8 +93,11 @@ bool estaOrdenadaPorNaturales(TCadena cad)  {
 /*
   Devuelve 'true' si y solo si los componentes naturales de algún par de 
   elementos de 'cad' son iguales.  
+  El tiempo de ejecución en el peor caso es O(n^2), siendo 'n' la cantidad de
+  elementos de 'cad'.
 */
 bool hayNatsRepetidos(TCadena cad) {
+  contarLlamada(opHayNatsRepetidos);
   bool res = false;
 /* while ((aux != NULL) && (siguienteClave(natInfo(infoCadena(aux, cad)), aux, cad) == NULL)) {
     aux = siguiente(aux, cad);
@@ -91,6 +116,7 @@ bool hayNatsRepetidos(TCadena cad) {
       while ((aux != NULL)  && (!res))
       {
         aux = siguiente(aux, cad);
+        contarNodos(opHayNatsRepetidos, 1);
         if (aux != NULL){
           res = (siguienteClave( n, aux, cad) != NULL);
           info = infoCadena(aux, cad);
@@ -113,6 +139,7 @@ bool hayNatsRepetidos(TCadena cad) {
   cantidad de elementos de 'c1' y 'c2' respectivamente.
 */
 bool sonIgualesCadena(TCadena c1, TCadena c2) {
+  contarLlamada(opSonIgualesCadena);
   if ((esVaciaCadena(c1)) && (esVaciaCadena(c2))) {
     return true;
   } else if (((esVaciaCadena(c1)) && (!esVaciaCadena(c2))) || ((!esVaciaCadena(c1)) && (esVaciaCadena(c2)))) {
@@ -127,6 +154,7 @@ bool sonIgualesCadena(TCadena c1, TCadena c2) {
       while (((i != NULL) || (j != NULL)) && (sonIgualesInfo((infoCadena(i, c1)), (infoCadena(j, c2))))) {
         i = siguiente(i, c1);
         j = siguiente(j, c2);
+        contarNodos(opSonIgualesCadena, 1);
       }
       return ((i == NULL) && (j == NULL));
     }
@@ -140,6 +168,7 @@ bool sonIgualesCadena(TCadena c1, TCadena c2) {
   cantidad de elementos de 'c1' y 'c2' respectivamente.
 */
 TCadena concatenar(TCadena c1, TCadena c2){
+  contarLlamada(opConcatenar);
   TCadena i,j;
   i = copiarSegmento(inicioCadena(c1),finalCadena(c1),c1);
   j = copiarSegmento(inicioCadena(c2),finalCadena(c2),c2);
@@ -150,7 +179,8 @@ TCadena concatenar(TCadena c1, TCadena c2){
   Se ordena 'cad' de manera creciente según los componentes naturales de sus
   elementos.
   Devuelve 'cad'
-  Precondición: ! hayNatsRepetidos(cad)
+  Precondición: ! hayNatsRepetidos(cad), que se puede establecer en O(n) con
+  'eliminarRepetidos'.
   No se debe obtener ni devolver memoria de manera dinámica.
   Se debe mantener las relaciones de precedencia entre localizadores.
   Si esVaciaCadena(cad) no hace nada.
@@ -158,28 +188,9 @@ TCadena concatenar(TCadena c1, TCadena c2){
   elementos de 'cad'.
 */
 TCadena ordenar(TCadena cad){
-  if ((!esVaciaCadena(cad)) && (longitud(cad) > 1)) {
-    TLocalizador loc1, loc2, loc3;
-    loc1 = loc3 = finalCadena(cad);
-    loc2 = anterior(loc1, cad);
-    while (loc3 != NULL){
-      loc1 = loc3;
-      while (loc2 != NULL) {
-        nat n1, n2;
-        n1 = natInfo(infoCadena(loc1, cad));
-        n2 = natInfo(infoCadena(loc2, cad));
-        if (n2 > n1)  {
-          intercambiar(loc1,loc2,cad);
-        }
-        loc1 = anterior(loc1, cad);
-        loc2 = anterior(loc2, cad);
-      }
-      loc3 = anterior(loc3, cad);
-    }
-  } while (!estaOrdenadaPorNaturales(cad)){
-    ordenar(cad);
-  }
-  return cad;
+  contarLlamada(opOrdenar);
+  // se ordena por inserción, o con una red de ordenamiento si es corta
+  return ordenarCadena(cad);
 }
 
 /*
@@ -191,6 +202,7 @@ TCadena ordenar(TCadena cad){
   elementos de 'cad'.
 */
 TCadena cambiarTodos(nat original, nat nuevo, TCadena cad)  {
+  contarLlamada(opCambiarTodos);
   TLocalizador aux;
   aux = inicioCadena(cad);;
   if (original != nuevo) 
@@ -208,7 +220,7 @@ TCadena cambiarTodos(nat original, nat nuevo, TCadena cad)  {
         cad = cambiarEnCadena(i,aux,cad);
         aux = siguienteClave(original,aux,cad);
         i = NULL;
-        liberarInfo(x);
+        retirar(x, NULL, liberarInfoRetirada);
       }
     }
   }
@@ -226,17 +238,113 @@ TCadena cambiarTodos(nat original, nat nuevo, TCadena cad)  {
   elementos de 'cad'.
 */
 TCadena subCadena(nat menor, nat mayor, TCadena cad)  {
+  contarLlamada(opSubCadena);
   TLocalizador i, j;
   TCadena res;
-  i = inicioCadena(cad);
-  j = finalCadena(cad);
-  if (natInfo(infoCadena(i,cad)) != menor)  {
-    i = siguienteClave(menor,i,cad);
-  }
-  if (natInfo(infoCadena(j,cad)) != mayor) { 
-    j = anteriorClave(mayor,j,cad);
+  // las cotas son O(log n) si 'cad' está en modo ordenado
+  i = cotaInferior(menor, cad);
+  j = cotaSuperior(mayor, cad);
+  if (esLocalizador(j)) {
+    j = anterior(j, cad);
+  } else {
+    j = finalCadena(cad);
   }
   res = copiarSegmento(i,j,cad);
   return res;
 }
 
+/*
+  Devuelve la unión de 'c1' y 'c2' según los componentes naturales: los
+  elementos de 'c1' y los de 'c2' cuyo componente natural no es el de ningún
+  elemento de 'c1', ordenados de manera no decreciente según los componentes
+  naturales. Los de 'c1' quedan antes que los de 'c2' con igual componente.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente.
+*/
+TCadena unionCadenas(TCadena c1, TCadena c2) {
+  contarLlamada(opUnionCadenas);
+  TCadena res = crearCadena();
+  TLocalizador i = inicioCadena(c1);
+  TLocalizador j = inicioCadena(c2);
+  while (esLocalizador(i) || esLocalizador(j)) {
+    if (!esLocalizador(j) ||
+        (esLocalizador(i) &&
+         (natInfo(infoCadena(i, c1)) <= natInfo(infoCadena(j, c2))))) {
+      nat clave = natInfo(infoCadena(i, c1));
+      insertarAlFinal(copiaInfo(infoCadena(i, c1)), res);
+      i = siguienteSinVerificar(i, c1);
+      // los de 'c2' con la misma clave no van
+      while (esLocalizador(j) && (natInfo(infoCadena(j, c2)) == clave)) {
+        j = siguienteSinVerificar(j, c2);
+        contarNodos(opUnionCadenas, 1);
+      }
+    } else {
+      insertarAlFinal(copiaInfo(infoCadena(j, c2)), res);
+      j = siguienteSinVerificar(j, c2);
+    }
+    contarNodos(opUnionCadenas, 1);
+  }
+  return res;
+}
+
+/*
+  Devuelve la intersección de 'c1' y 'c2' según los componentes naturales:
+  los elementos de 'c1' cuyo componente natural es el de algún elemento de
+  'c2', en el mismo orden.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente. Si las dos cadenas
+  están indexadas los tramos que se saltean se ubican con el índice, y si
+  una es mucho más corta es O(m log n) en promedio, siendo 'm' y 'n' la
+  cantidad de elementos de la más corta y de la más larga.
+*/
+TCadena interseccionCadenas(TCadena c1, TCadena c2) {
+  contarLlamada(opInterseccionCadenas);
+  TCadena res = crearCadena();
+  TLocalizador i = inicioCadena(c1);
+  TLocalizador j = inicioCadena(c2);
+  while (esLocalizador(i) && esLocalizador(j)) {
+    nat a = natInfo(infoCadena(i, c1));
+    nat b = natInfo(infoCadena(j, c2));
+    if (a < b) {
+      i = galoparClave(b, i, c1);
+    } else if (b < a) {
+      j = galoparClave(a, j, c2);
+    } else {
+      insertarAlFinal(copiaInfo(infoCadena(i, c1)), res);
+      i = siguienteSinVerificar(i, c1);
+      contarNodos(opInterseccionCadenas, 1);
+    }
+  }
+  return res;
+}
+
+/*
+  Devuelve la diferencia de 'c1' y 'c2' según los componentes naturales: los
+  elementos de 'c1' cuyo componente natural no es el de ningún elemento de
+  'c2', en el mismo orden.
+  La 'TCadena' resultado no comparte memoria ni con 'c1' ni con 'c2'.
+  Precondición: estaOrdenadaPorNaturales(c1), estaOrdenadaPorNaturales(c2).
+  El tiempo de ejecución en el peor caso es O(n1 + n2), siendo 'n1' u 'n2' la
+  cantidad de elementos de 'c1' y 'c2' respectivamente. Si estaIndexada(c2)
+  es O(n1 log n2) en promedio.
+*/
+TCadena diferenciaCadenas(TCadena c1, TCadena c2) {
+  contarLlamada(opDiferenciaCadenas);
+  TCadena res = crearCadena();
+  TLocalizador i = inicioCadena(c1);
+  TLocalizador j = inicioCadena(c2);
+  while (esLocalizador(i)) {
+    nat clave = natInfo(infoCadena(i, c1));
+    j = galoparClave(clave, j, c2);
+    if (!esLocalizador(j) || (natInfo(infoCadena(j, c2)) != clave)) {
+      insertarAlFinal(copiaInfo(infoCadena(i, c1)), res);
+    }
+    i = siguienteSinVerificar(i, c1);
+    contarNodos(opDiferenciaCadenas, 1);
+  }
+  return res;
+}
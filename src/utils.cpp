@@ -1,36 +1,245 @@
 /*
   Módulo de implementación de 'utils'.
 
+  La entrada estándar se lee con 'read' en un tampón grande y los números se
+  interpretan directamente sobre el tampón, sin pasar por 'scanf'.
+  Cada hilo lee del lector fijado con 'fijarLectorActual', que por omisión es
+  el de la entrada estándar.
+
   Laboratorio de Programación 2.
   InCo-FIng-UDELAR
 */
 
 #include "../include/utils.h"
 
-#include "stdio.h"
+#include <ctype.h>  // isspace
+#include <errno.h>
+#include <limits.h> // UINT_MAX
+#include <stdio.h>  // fflush
+#include <string.h> // memmove
+#include <unistd.h> // read
+
+#include <charconv> // from_chars
+
+#define TAM_TAMPON_ENTRADA (1 << 20)
+
+struct repLector {
+  int fd;    // -1 si se lee de memoria
+  char *tampon;
+  nat pos;   // próximo carácter a leer
+  nat largo; // cantidad de caracteres válidos en 'tampon'
+  bool fin;  // no hay más datos en 'fd'
+  bool interactiva;
+};
+
+static char tamponEstandar[TAM_TAMPON_ENTRADA];
+static repLector estandar = {0, tamponEstandar, 0, 0, false, true};
+static thread_local repLector *actual = &estandar;
+
+/*
+  Descarta los caracteres ya leídos y agrega al tampón lo que esté disponible
+  en el descriptor. Devuelve 'false' si no se agregó nada.
+*/
+static bool rellenar(repLector &l) {
+  if (l.fin)
+    return false;
+  if (l.pos > 0) {
+    memmove(l.tampon, l.tampon + l.pos, l.largo - l.pos);
+    l.largo -= l.pos;
+    l.pos = 0;
+  }
+  if (l.largo == TAM_TAMPON_ENTRADA)
+    return false;
+  // lo que se haya escrito (por ejemplo el prompt) debe verse antes de
+  // quedar esperando la entrada
+  if (l.interactiva)
+    fflush(stdout);
+  ssize_t leidos;
+  do {
+    leidos = read(l.fd, l.tampon + l.largo, TAM_TAMPON_ENTRADA - l.largo);
+  } while ((leidos < 0) && (errno == EINTR));
+  if (leidos <= 0) {
+    l.fin = true;
+    return false;
+  }
+  l.largo += leidos;
+  return true;
+}
+
+/*
+  Devuelve el próximo carácter sin consumirlo, o EOF si no hay más.
+*/
+static int verCaracter(repLector &l) {
+  if ((l.pos == l.largo) && !rellenar(l))
+    return EOF;
+  return (unsigned char)l.tampon[l.pos];
+}
+
+/*
+  Devuelve el próximo carácter y lo consume, o EOF si no hay más.
+*/
+static int tomarCaracter(repLector &l) {
+  int c = verCaracter(l);
+  if (c != EOF)
+    l.pos++;
+  return c;
+}
+
+static void saltarBlancos(repLector &l) {
+  int c = verCaracter(l);
+  while ((c != EOF) && isspace(c)) {
+    l.pos++;
+    c = verCaracter(l);
+  }
+}
+
+/*
+  Se asegura de que el tampón contenga completa la palabra que empieza en la
+  posición actual (hasta un blanco, un paréntesis o una coma), salvo que sea
+  más larga que el tampón.
+*/
+static void asegurarPalabra(repLector &l) {
+  nat i = l.pos;
+  bool completa = false;
+  while (!completa) {
+    while ((i < l.largo) && !isspace((unsigned char)l.tampon[i]) &&
+           (l.tampon[i] != '(') && (l.tampon[i] != ',') && (l.tampon[i] != ')'))
+      i++;
+    if (i < l.largo) {
+      completa = true;
+    } else {
+      nat desplazamiento = l.pos;
+      completa = !rellenar(l);
+      i -= desplazamiento;
+    }
+  }
+}
 
 nat leerNat() {
-  nat res;
-  scanf("%u", &res);
-  return res;
+  repLector &entrada = *actual;
+  saltarBlancos(entrada);
+  asegurarPalabra(entrada);
+  const char *p = entrada.tampon + entrada.pos;
+  const char *fin = entrada.tampon + entrada.largo;
+  // como 'scanf("%u")', se acepta un signo y los negativos dan la vuelta
+  bool negativo = false;
+  if ((p < fin) && ((*p == '-') || (*p == '+'))) {
+    negativo = (*p == '-');
+    p++;
+  }
+  nat res = 0;
+  while ((p < fin) && (*p >= '0') && (*p <= '9')) {
+    res = res * 10 + (nat)(*p - '0');
+    p++;
+  }
+  entrada.pos = p - entrada.tampon;
+  return negativo ? -res : res;
 }
 
 char leerChar() {
-  char res;
-  scanf(" %c", &res);
-  return res;
+  repLector &entrada = *actual;
+  saltarBlancos(entrada);
+  int c = tomarCaracter(entrada);
+  return (c == EOF) ? '\0' : (char)c;
 }
 
 double leerDouble() {
-  double res;
-  scanf("%lf", &res);
+  repLector &entrada = *actual;
+  saltarBlancos(entrada);
+  asegurarPalabra(entrada);
+  const char *p = entrada.tampon + entrada.pos;
+  const char *fin = entrada.tampon + entrada.largo;
+  // 'from_chars' no acepta el signo '+'
+  if ((p < fin) && (*p == '+'))
+    p++;
+  double res = 0;
+  std::from_chars_result r = std::from_chars(p, fin, res);
+  if (r.ec == std::errc::invalid_argument)
+    res = 0;
+  else
+    entrada.pos = r.ptr - entrada.tampon;
   return res;
 }
 
-void leerChars(ArregloChars cs) {
-  scanf("%s", cs);
+/*
+  Copia en 'cs' los caracteres siguientes mientras no sean EOF ni cumplan
+  'corta', guardando a lo sumo 'tope' - 1 y descartando el resto.
+*/
+static void copiarHasta(ArregloChars cs, nat tope, bool (*corta)(int c),
+                        repLector &entrada) {
+  nat copiados = 0;
+  int c = verCaracter(entrada);
+  while ((c != EOF) && !corta(c)) {
+    if (copiados + 1 < tope) {
+      cs[copiados] = (char)c;
+      copiados++;
+    }
+    entrada.pos++;
+    c = verCaracter(entrada);
+  }
+  cs[copiados] = '\0';
+}
+
+static bool esBlanco(int c) { return isspace(c); }
+
+static bool esFinLinea(int c) { return c == '\n'; }
+
+void leerChars(ArregloChars cs) { leerCharsAcotado(cs, UINT_MAX); }
+
+void leerCharsAcotado(ArregloChars cs, nat tope) {
+  repLector &entrada = *actual;
+  saltarBlancos(entrada);
+  copiarHasta(cs, tope, esBlanco, entrada);
+}
+
+void leerRestoLinea(ArregloChars cs) { leerRestoLineaAcotado(cs, UINT_MAX); }
+
+void leerRestoLineaAcotado(ArregloChars cs, nat tope) {
+  copiarHasta(cs, tope, esFinLinea, *actual);
 }
 
-void leerRestoLinea(ArregloChars cs) {
-  scanf("%[^\n]", cs);
+void descartarRestoLinea() {
+  repLector &entrada = *actual;
+  int c = tomarCaracter(entrada);
+  while ((c != EOF) && (c != '\n'))
+    c = tomarCaracter(entrada);
+}
+
+void prepararEntradaEnLote() { estandar.interactiva = false; }
+
+bool finEntrada() {
+  repLector &entrada = *actual;
+  saltarBlancos(entrada);
+  return verCaracter(entrada) == EOF;
+}
+
+bool leerParNatReal(nat *natural, double *real) {
+  bool res = (leerChar() == '(');
+  if (res) {
+    *natural = leerNat();
+    res = (leerChar() == ',');
+  }
+  if (res) {
+    *real = leerDouble();
+    res = (leerChar() == ')');
+  }
+  return res;
+}
+
+TLector crearLectorMemoria(const char *datos, nat largo) {
+  TLector res = new repLector;
+  res->fd = -1;
+  // el tampón nunca se modifica porque un lector de memoria no se rellena
+  res->tampon = (char *)datos;
+  res->pos = 0;
+  res->largo = largo;
+  res->fin = true;
+  res->interactiva = false;
+  return res;
+}
+
+void liberarLector(TLector lector) { delete lector; }
+
+void fijarLectorActual(TLector lector) {
+  actual = (lector == NULL) ? &estandar : lector;
 }
@@ -0,0 +1,605 @@
+/*
+  Pruebas de complejidad de las operaciones de 'cadena' y 'usoTads'.
+
+  Cada caso ejecuta una operación sobre cadenas de tamaños que crecen
+  geométricamente y toma como costo la cantidad de llamadas, de nodos
+  recorridos y de 'TInfo' creados y liberados que cuenta 'estadisticas'. Los
+  'TInfo' liberados hacen que se cuente el costo de liberar nodos, que se
+  hace al retirarlos y no lo cuenta cada operación. El exponente de crecimiento se estima
+  con la pendiente, por mínimos cuadrados, de log(costo) en función de
+  log(n), y el caso falla si supera en más de TOLERANCIA el exponente de la
+  cota documentada en cadena.h o usoTads.h.
+
+  Se debe compilar sin 'assert' (con NDEBUG): las verificaciones de las
+  precondiciones también se cuentan y cambiarían el crecimiento.
+
+  Imprime una línea por caso y termina con estado 1 si algún caso falla.
+
+  Uso:
+    complejidad [--min N] [--max N]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/cadena.h"
+#include "../include/estadisticas.h"
+#include "../include/info.h"
+#include "../include/salida.h"
+#include "../include/usoTads.h"
+#include "../include/utils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+// Diferencia máxima admitida entre el exponente observado y el de la cota.
+#define TOLERANCIA 0.25
+
+/*
+  Ejecuta la operación medida sobre 'cad', de 'n' elementos. Lo que se haga
+  antes de invocar a 'empezar' no se cuenta.
+*/
+typedef void (*TOperar)(nat n, TCadena cad);
+
+struct caso {
+  const char *operacion;
+  const char *cota;
+  double exponente;
+  TOperar operar;
+};
+
+// 'TInfo' creados y liberados antes de 'empezar'.
+static unsigned long infosAntes = 0;
+
+// Cadena que devolvió la operación medida y se libera después de medir.
+static TCadena descartada = NULL;
+
+/*
+  Pone en 0 los contadores: a partir de aquí se cuenta el costo.
+*/
+static void empezar() {
+  reiniciarEstadisticas();
+  infosAntes = infosCreadas() + infosLiberadas();
+}
+
+static unsigned long costo() {
+  unsigned long res = infosCreadas() + infosLiberadas() - infosAntes;
+  for (nat op = 0; op < CANT_OPERACIONES; op++)
+    res += llamadasOperacion((TOperacion)op) + nodosOperacion((TOperacion)op);
+  return res;
+}
+
+/*
+  Deja 'cad' para liberarla después de medir, cuando liberarla no es parte de
+  la operación medida y costaría más que ella.
+*/
+static void descartar(TCadena cad) { descartada = cad; }
+
+/*
+  Devuelve la cadena (1,0.5), (2,1.0), ..., (n,n*0.5), o en orden inverso
+  si 'inversa'.
+*/
+static TCadena armarCadena(nat n, bool inversa) {
+  TCadena cad = crearCadena();
+  for (nat i = 1; i <= n; i++) {
+    nat c = inversa ? n + 1 - i : i;
+    insertarAlFinal(crearInfo(c, c * 0.5), cad);
+  }
+  return cad;
+}
+
+static TLocalizador medio(nat n, TCadena cad) { return kesimo(n / 2, cad); }
+
+// operaciones de cadena
+
+static void medirInsertarAlFinal(nat n, TCadena cad) {
+  empezar();
+  insertarAlFinal(crearInfo(0, 0), cad);
+}
+
+static void medirInsertarAntes(nat n, TCadena cad) {
+  TLocalizador loc = medio(n, cad);
+  empezar();
+  insertarAntes(crearInfo(0, 0), loc, cad);
+}
+
+static void medirRemoverDeCadena(nat n, TCadena cad) {
+  TLocalizador loc = medio(n, cad);
+  empezar();
+  removerDeCadena(loc, cad);
+}
+
+static void medirIntercambiar(nat n, TCadena cad) {
+  TLocalizador inicio = inicioCadena(cad), final = finalCadena(cad);
+  empezar();
+  intercambiar(inicio, final, cad);
+}
+
+static void medirCambiarEnCadena(nat n, TCadena cad) {
+  TLocalizador loc = medio(n, cad);
+  TInfo anterior = infoCadena(loc, cad);
+  empezar();
+  cambiarEnCadena(crearInfo(0, 0), loc, cad);
+  liberarInfo(anterior);
+}
+
+static void medirInsertarSegmentoDespues(nat n, TCadena cad) {
+  TCadena sgm = armarCadena(n, false);
+  TLocalizador loc = medio(n, cad);
+  empezar();
+  insertarSegmentoDespues(sgm, loc, cad);
+}
+
+static void medirCopiarSegmentoCorto(nat n, TCadena cad) {
+  TLocalizador hasta = finalCadena(cad);
+  TLocalizador desde = kesimo(n - 9, cad);
+  empezar();
+  liberarCadena(copiarSegmento(desde, hasta, cad));
+}
+
+static void medirCopiarSegmento(nat n, TCadena cad) {
+  empezar();
+  liberarCadena(copiarSegmento(inicioCadena(cad), finalCadena(cad), cad));
+}
+
+static void medirBorrarSegmento(nat n, TCadena cad) {
+  empezar();
+  borrarSegmento(inicioCadena(cad), finalCadena(cad), cad);
+}
+
+static void medirKesimo(nat n, TCadena cad) {
+  empezar();
+  kesimo(n, cad);
+}
+
+static void medirLocalizadorEnCadena(nat n, TCadena cad) {
+  TLocalizador final = finalCadena(cad);
+  empezar();
+  localizadorEnCadena(final, cad);
+}
+
+static void medirPrecedeEnCadena(nat n, TCadena cad) {
+  TLocalizador inicio = inicioCadena(cad), final = finalCadena(cad);
+  empezar();
+  precedeEnCadena(inicio, final, cad);
+}
+
+static void medirSiguienteClave(nat n, TCadena cad) {
+  empezar();
+  siguienteClave(0, inicioCadena(cad), cad);
+}
+
+static void medirAnteriorClave(nat n, TCadena cad) {
+  empezar();
+  anteriorClave(0, finalCadena(cad), cad);
+}
+
+static void medirMenorEnCadena(nat n, TCadena cad) {
+  empezar();
+  menorEnCadena(inicioCadena(cad), cad);
+}
+
+static void medirImprimirCadena(nat n, TCadena cad) {
+  TBufferSalida buf = crearBufferSalida(16 * n);
+  empezar();
+  imprimirCadenaEnBuffer(buf, cad);
+  liberarBufferSalida(buf);
+}
+
+static void medirLiberarCadena(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  liberarCadena(otra);
+}
+
+// operaciones de usoTads
+
+static void medirPertenece(nat n, TCadena cad) {
+  empezar();
+  pertenece(0, cad);
+}
+
+static void medirLongitud(nat n, TCadena cad) {
+  empezar();
+  longitud(cad);
+}
+
+static void medirEstaOrdenadaPorNaturales(nat n, TCadena cad) {
+  empezar();
+  estaOrdenadaPorNaturales(cad);
+}
+
+static void medirHayNatsRepetidos(nat n, TCadena cad) {
+  empezar();
+  hayNatsRepetidos(cad);
+}
+
+static void medirSonIgualesCadena(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  sonIgualesCadena(cad, otra);
+  liberarCadena(otra);
+}
+
+static void medirConcatenar(nat n, TCadena cad) {
+  empezar();
+  liberarCadena(concatenar(cad, cad));
+}
+
+static void medirOrdenar(nat n, TCadena cad) {
+  TCadena inversa = armarCadena(n, true);
+  empezar();
+  ordenar(inversa);
+  liberarCadena(inversa);
+}
+
+static void medirCambiarTodos(nat n, TCadena cad) {
+  TCadena iguales = crearCadena();
+  for (nat i = 0; i < n; i++)
+    insertarAlFinal(crearInfo(1, i), iguales);
+  empezar();
+  cambiarTodos(1, 2, iguales);
+  liberarCadena(iguales);
+}
+
+static void medirSubCadena(nat n, TCadena cad) {
+  empezar();
+  liberarCadena(subCadena(1, n, cad));
+}
+
+// operaciones sobre cadenas en modo ordenado
+
+static void medirIndexarCadena(nat n, TCadena cad) {
+  empezar();
+  indexarCadena(cad);
+}
+
+static void medirInsertarOrdenado(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  insertarOrdenado(crearInfo(n / 2, 0), cad);
+}
+
+static void medirBuscarClave(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  buscarClave(n, cad);
+}
+
+static void medirCotaInferior(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  cotaInferior(n, cad);
+}
+
+static void medirCotaSuperior(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  cotaSuperior(n / 2, cad);
+}
+
+static void medirGaloparClave(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  galoparClave(n, inicioCadena(cad), cad);
+}
+
+static void medirRemoverIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  TLocalizador loc = medio(n, cad);
+  empezar();
+  removerDeCadena(loc, cad);
+}
+
+static void medirContarEnRango(nat n, TCadena cad) {
+  empezar();
+  contarEnRango(n / 4, 3 * n / 4, cad);
+}
+
+static void medirContarEnRangoIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  contarEnRango(n / 4, 3 * n / 4, cad);
+}
+
+static void medirSumaReales(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  sumaReales(n / 4, 3 * n / 4, cad);
+}
+
+static void medirMinMaxReal(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  minReal(n / 4, 3 * n / 4, cad);
+  maxReal(1, n, cad);
+}
+
+static void medirMezclar(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  mezclar(cad, otra);
+}
+
+static void medirMezclarIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  TCadena corta = crearCadena();
+  for (nat i = 1; i <= 10; i++)
+    insertarAlFinal(crearInfo(i * n / 10, 0), corta);
+  empezar();
+  mezclar(cad, corta);
+}
+
+/*
+  Devuelve una cadena indexada con 10 elementos de claves repartidas entre 1
+  y 'n'.
+*/
+static TCadena armarCorta(nat n) {
+  TCadena corta = crearCadena();
+  for (nat i = 1; i <= 10; i++)
+    insertarAlFinal(crearInfo(i * n / 10, 0), corta);
+  return indexarCadena(corta);
+}
+
+static void medirUnionCadenas(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  liberarCadena(unionCadenas(cad, otra));
+  liberarCadena(otra);
+}
+
+static void medirInterseccionIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  TCadena corta = armarCorta(n);
+  empezar();
+  liberarCadena(interseccionCadenas(cad, corta));
+  liberarCadena(corta);
+}
+
+static void medirDiferenciaCadenas(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  liberarCadena(diferenciaCadenas(cad, otra));
+  liberarCadena(otra);
+}
+
+static void medirUnirCadenas(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  unirCadenas(cad, otra);
+}
+
+static void medirIntersecarCadenas(nat n, TCadena cad) {
+  TCadena otra = armarCadena(n, false);
+  empezar();
+  intersecarCadenas(cad, otra);
+}
+
+static void medirRestarIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  TCadena corta = armarCorta(n);
+  empezar();
+  restarCadenas(cad, corta);
+}
+
+static void medirEliminarRepetidos(nat n, TCadena cad) {
+  for (nat i = n / 2; i > 0; i--)
+    insertarAlFinal(crearInfo(i, 0), cad);
+  empezar();
+  eliminarRepetidos(cad, ultimaOcurrencia);
+}
+
+static void medirEliminarRepetidosIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  for (nat i = 1; i <= n / 2; i++)
+    insertarOrdenado(crearInfo(2 * i, 0), cad);
+  empezar();
+  eliminarRepetidos(cad, primeraOcurrencia);
+}
+
+static bool esPar(TInfo info, void *contexto) {
+  return natInfo(info) % 2 == 0;
+}
+
+static void medirFiltrarCadena(nat n, TCadena cad) {
+  empezar();
+  filtrarCadena(cad, esPar, NULL);
+}
+
+static void medirParticionarCadena(nat n, TCadena cad) {
+  empezar();
+  liberarCadena(particionarCadena(cad, esPar, NULL));
+}
+
+static void medirFiltrarRangoIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  filtrarRango(3, n - 2, cad);
+}
+
+static void medirParticionarRangoIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  descartar(particionarRango(3, n - 2, cad));
+}
+
+static void medirInvertirCadena(nat n, TCadena cad) {
+  empezar();
+  invertirCadena(cad);
+}
+
+static void medirNormalizar(nat n, TCadena cad) {
+  invertirCadena(cad);
+  empezar();
+  normalizar(cad);
+}
+
+static void medirPartirCadena(nat n, TCadena cad) {
+  TLocalizador loc = kesimo(n / 2, cad);
+  empezar();
+  descartar(partirCadena(loc, cad));
+}
+
+static void medirPartirCadenaIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  TLocalizador loc = kesimo(n / 2, cad);
+  empezar();
+  descartar(partirCadena(loc, cad));
+}
+
+static void medirMoverSegmento(nat n, TCadena cad) {
+  TLocalizador desde = kesimo(n / 4, cad);
+  TLocalizador hasta = kesimo(n / 2, cad);
+  TLocalizador destinoLoc = kesimo(3 * n / 4, cad);
+  empezar();
+  moverSegmento(desde, hasta, cad, destinoLoc, cad);
+}
+
+static void medirMoverSegmentoOtra(nat n, TCadena cad) {
+  TCadena origen = armarCadena(10, false);
+  TLocalizador desde = kesimo(2, origen);
+  TLocalizador hasta = kesimo(9, origen);
+  TLocalizador destinoLoc = medio(n, cad);
+  empezar();
+  moverSegmento(desde, hasta, origen, destinoLoc, cad);
+  liberarCadena(origen);
+}
+
+static void medirSubCadenaIndexada(nat n, TCadena cad) {
+  indexarCadena(cad);
+  empezar();
+  liberarCadena(subCadena(n - 9, n, cad));
+}
+
+static const caso casos[] = {
+    {"insertarAlFinal", "O(1)", 0, medirInsertarAlFinal},
+    {"insertarAntes", "O(1)", 0, medirInsertarAntes},
+    {"removerDeCadena", "O(1)", 0, medirRemoverDeCadena},
+    {"intercambiar", "O(1)", 0, medirIntercambiar},
+    {"cambiarEnCadena", "O(1)", 0, medirCambiarEnCadena},
+    {"insertarSegmentoDespues", "O(1)", 0, medirInsertarSegmentoDespues},
+    {"copiarSegmento (10 elem.)", "O(k)", 0, medirCopiarSegmentoCorto},
+    {"copiarSegmento", "O(n)", 1, medirCopiarSegmento},
+    {"borrarSegmento", "O(n)", 1, medirBorrarSegmento},
+    {"kesimo", "O(n)", 1, medirKesimo},
+    {"localizadorEnCadena", "O(n)", 1, medirLocalizadorEnCadena},
+    {"precedeEnCadena", "O(n)", 1, medirPrecedeEnCadena},
+    {"siguienteClave", "O(n)", 1, medirSiguienteClave},
+    {"anteriorClave", "O(n)", 1, medirAnteriorClave},
+    {"menorEnCadena", "O(n)", 1, medirMenorEnCadena},
+    {"imprimirCadena", "O(n)", 1, medirImprimirCadena},
+    {"liberarCadena", "O(n)", 1, medirLiberarCadena},
+    {"pertenece", "O(n)", 1, medirPertenece},
+    {"longitud", "O(n)", 1, medirLongitud},
+    {"estaOrdenadaPorNaturales", "O(n)", 1, medirEstaOrdenadaPorNaturales},
+    {"hayNatsRepetidos", "O(n^2)", 2, medirHayNatsRepetidos},
+    {"sonIgualesCadena", "O(n1 + n2)", 1, medirSonIgualesCadena},
+    {"concatenar", "O(n1 + n2)", 1, medirConcatenar},
+    {"ordenar", "O(n^2)", 2, medirOrdenar},
+    {"cambiarTodos", "O(n)", 1, medirCambiarTodos},
+    {"subCadena", "O(n)", 1, medirSubCadena},
+    {"indexarCadena", "O(n)", 1, medirIndexarCadena},
+    {"insertarOrdenado (ordenada)", "O(log n)", 0, medirInsertarOrdenado},
+    {"buscarClave (ordenada)", "O(log n)", 0, medirBuscarClave},
+    {"cotaInferior (ordenada)", "O(log n)", 0, medirCotaInferior},
+    {"cotaSuperior (ordenada)", "O(log n)", 0, medirCotaSuperior},
+    {"galoparClave (ordenada)", "O(log n)", 0, medirGaloparClave},
+    {"removerDeCadena (ordenada)", "O(log n)", 0, medirRemoverIndexada},
+    {"subCadena (ordenada)", "O(log n + k)", 0, medirSubCadenaIndexada},
+    {"mezclar", "O(n1 + n2)", 1, medirMezclar},
+    {"mezclar (ordenada, 10 el.)", "O(k log n)", 0, medirMezclarIndexada},
+    {"unionCadenas", "O(n1 + n2)", 1, medirUnionCadenas},
+    {"interseccion (ord., 10 el.)", "O(k log n)", 0, medirInterseccionIndexada},
+    {"diferenciaCadenas", "O(n1 + n2)", 1, medirDiferenciaCadenas},
+    {"unirCadenas", "O(n1 + n2)", 1, medirUnirCadenas},
+    {"intersecarCadenas", "O(n1 + n2)", 1, medirIntersecarCadenas},
+    {"restar (ord., 10 el.)", "O(k log n)", 0, medirRestarIndexada},
+    {"eliminarRepetidos", "O(n)", 1, medirEliminarRepetidos},
+    {"eliminarRepetidos (ord.)", "O(n)", 1, medirEliminarRepetidosIndexada},
+    {"filtrarCadena", "O(n)", 1, medirFiltrarCadena},
+    {"particionarCadena", "O(n)", 1, medirParticionarCadena},
+    {"filtrarRango (ord.)", "O(log n + k)", 0, medirFiltrarRangoIndexada},
+    {"particionarRango (ord.)", "O(log n + k)", 0,
+     medirParticionarRangoIndexada},
+    {"invertirCadena", "O(1)", 0, medirInvertirCadena},
+    {"normalizar", "O(n)", 1, medirNormalizar},
+    {"partirCadena", "O(1)", 0, medirPartirCadena},
+    {"partirCadena (ordenada)", "O(log n)", 0, medirPartirCadenaIndexada},
+    {"moverSegmento", "O(1)", 0, medirMoverSegmento},
+    {"moverSegmento (a otra)", "O(1)", 0, medirMoverSegmentoOtra},
+    {"contarEnRango", "O(n)", 1, medirContarEnRango},
+    {"contarEnRango (ordenada)", "O(log n)", 0, medirContarEnRangoIndexada},
+    {"sumaReales (ordenada)", "O(log n)", 0, medirSumaReales},
+    {"min/maxReal (ordenada)", "O(log n)", 0, medirMinMaxReal},
+};
+
+static const nat CANT_CASOS = sizeof(casos) / sizeof(caso);
+
+/*
+  Devuelve la pendiente de la recta de mínimos cuadrados por los puntos
+  ('xs[i]', 'ys[i]').
+*/
+static double pendiente(const std::vector<double> &xs,
+                        const std::vector<double> &ys) {
+  double n = xs.size(), sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    sx += xs[i];
+    sy += ys[i];
+    sxx += xs[i] * xs[i];
+    sxy += xs[i] * ys[i];
+  }
+  return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+int main(int argc, char *argv[]) {
+  nat minimo = 500, maximo = 8000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--min") && (i + 1 < argc)) {
+      minimo = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--max") && (i + 1 < argc)) {
+      maximo = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Uso: %s [--min N] [--max N]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (!hayEstadisticas()) {
+    printf("Estadísticas no disponibles: no se verifica la complejidad.\n");
+    return 0;
+  }
+  if ((minimo < 16) || (maximo < 4 * minimo)) {
+    fprintf(stderr, "Se necesita 16 <= min y 4 * min <= max.\n");
+    return 1;
+  }
+
+  nat fallas = 0;
+  for (nat c = 0; c < CANT_CASOS; c++) {
+    std::vector<double> xs, ys;
+    for (nat n = minimo; n <= maximo; n *= 2) {
+      TCadena cad = armarCadena(n, false);
+      casos[c].operar(n, cad);
+      unsigned long medido = costo();
+      liberarCadena(cad);
+      if (descartada != NULL) {
+        liberarCadena(descartada);
+        descartada = NULL;
+      }
+      xs.push_back(log((double)n));
+      ys.push_back(log((double)(medido + 1)));
+    }
+    double exponente = pendiente(xs, ys);
+    if (fabs(exponente) < 0.005)
+      exponente = 0; // para no mostrar "-0.00"
+    bool falla = exponente > casos[c].exponente + TOLERANCIA;
+    fallas += falla;
+    printf("%-27s %-11s n^%.2f %s\n", casos[c].operacion, casos[c].cota,
+           exponente, falla ? "FALLA" : "ok");
+  }
+  if (fallas > 0)
+    printf("---- %u casos exceden la cota documentada ----\n", fallas);
+  return (fallas > 0) ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+/*
+  Prueba de recorridos concurrentes de 'cadena'.
+
+  Un hilo modifica una 'TCadena' con 'insertarAlFinal', 'insertarAntes',
+  'removerDeCadena' y 'borrarSegmento' mientras otros la recorren con
+  'pertenece', 'longitud', 'imprimirCadenaEnBuffer' y avanzando con
+  'siguienteSinVerificar' (ver el comienzo de cadena.h). Cada elemento es
+  (n,n*0.5), y los lectores verifican que todo elemento al que llegan lo
+  cumple, lo que falla si se llega a memoria ya liberada.
+
+  Se compila con ThreadSanitizer (ver 'testing-concurrencia' en el Makefile),
+  que informa las carreras en los enlaces y en la liberación de nodos.
+
+  Termina con 'abort' si un lector encuentra un elemento inválido o si al
+  final la cadena no tiene los elementos que dejó el hilo que la modifica.
+
+  Uso:
+    concurrencia [--pasos N] [--lectores N] [--semilla S]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/cadena.h"
+#include "../include/epocas.h"
+#include "../include/info.h"
+#include "../include/salida.h"
+#include "../include/usoTads.h"
+#include "../include/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Cantidad máxima de elementos de la cadena.
+#define MAX_ELEMENTOS 200
+// Los naturales de los elementos van de 1 a CANT_NATURALES.
+#define CANT_NATURALES 64
+
+static std::atomic<bool> terminar(false);
+static std::atomic<unsigned long> recorridos(0);
+
+static TInfo elemento(nat n) { return crearInfo(n, n * 0.5); }
+
+static void verificar(TInfo info) {
+  nat n = natInfo(info);
+  if ((n < 1) || (n > CANT_NATURALES) || (realInfo(info) != n * 0.5)) {
+    fprintf(stderr, "Elemento inválido (%u,%f).\n", n, realInfo(info));
+    abort();
+  }
+}
+
+/*
+  Recorre 'cad' hasta que se termine de modificarla.
+*/
+static void leer(TCadena cad, nat semilla) {
+  std::mt19937 azar(semilla);
+  TBufferSalida buf = crearBufferSalida(1024);
+  while (!terminar.load()) {
+    switch (azar() % 4) {
+    case 0:
+      pertenece(1 + azar() % CANT_NATURALES, cad);
+      break;
+    case 1:
+      longitud(cad);
+      break;
+    case 2:
+      imprimirCadenaEnBuffer(buf, cad);
+      vaciarBufferSalida(buf);
+      break;
+    default:
+      entrarLectura();
+      for (TLocalizador loc = inicioCadena(cad); loc != NULL;
+           loc = siguienteSinVerificar(loc, cad))
+        verificar(infoCadena(loc, cad));
+      salirLectura();
+    }
+    recorridos++;
+  }
+  liberarBufferSalida(buf);
+}
+
+/*
+  Modifica 'cad' con 'pasos' operaciones al azar y devuelve la cantidad de
+  elementos que deja.
+*/
+static nat escribir(TCadena cad, nat pasos, nat semilla) {
+  std::mt19937 azar(semilla);
+  nat n = 0;
+  for (nat i = 0; i < pasos; i++) {
+    nat op = azar() % 4;
+    if ((n == 0) || ((op <= 1) && (n < MAX_ELEMENTOS))) {
+      TInfo info = elemento(1 + azar() % CANT_NATURALES);
+      if ((op == 1) && (n > 0))
+        insertarAntes(info, kesimo(1 + azar() % n, cad), cad);
+      else
+        insertarAlFinal(info, cad);
+      n++;
+    } else if (op == 2) {
+      removerDeCadena(kesimo(1 + azar() % n, cad), cad);
+      n--;
+    } else {
+      nat k1 = 1 + azar() % n;
+      nat k2 = k1 + azar() % (n - k1 + 1);
+      if (k2 - k1 > 10)
+        k2 = k1 + 10;
+      borrarSegmento(kesimo(k1, cad), kesimo(k2, cad), cad);
+      n -= k2 - k1 + 1;
+    }
+  }
+  return n;
+}
+
+int main(int argc, char *argv[]) {
+  nat pasos = 200000, lectores = 3, semilla = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--pasos") && (i + 1 < argc)) {
+      pasos = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--lectores") && (i + 1 < argc)) {
+      lectores = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--semilla") && (i + 1 < argc)) {
+      semilla = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Uso: %s [--pasos N] [--lectores N] [--semilla S]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if ((lectores == 0) || (lectores >= MAX_LECTORES)) {
+    fprintf(stderr, "Se necesita 0 < lectores < %d.\n", MAX_LECTORES);
+    return 1;
+  }
+
+  TCadena cad = crearCadena();
+  std::vector<std::thread> hilos;
+  for (nat i = 0; i < lectores; i++)
+    hilos.emplace_back(leer, cad, semilla + 1 + i);
+  nat n = escribir(cad, pasos, semilla);
+  terminar.store(true);
+  for (std::thread &h : hilos)
+    h.join();
+
+  if (longitud(cad) != n) {
+    fprintf(stderr, "La cadena tiene %u elementos y debería tener %u.\n",
+            longitud(cad), n);
+    abort();
+  }
+  for (TLocalizador loc = inicioCadena(cad); loc != NULL;
+       loc = siguienteSinVerificar(loc, cad))
+    verificar(infoCadena(loc, cad));
+  liberarCadena(cad);
+  printf("%u pasos con %u lectores y %lu recorridos sin errores.\n", pasos,
+         lectores, recorridos.load());
+  return 0;
+}
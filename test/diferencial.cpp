@@ -0,0 +1,944 @@
+/*
+  Prueba diferencial de 'cadena' y 'usoTads'.
+
+  Ejecuta secuencias de operaciones al azar sobre una 'TCadena' y sobre un
+  modelo de referencia, un 'std::vector' de pares {natural, real}, y después
+  de cada paso compara los resultados, el texto impreso de la cadena, el
+  recorrido hacia atrás y la posición del localizador. El localizador se
+  simula en el modelo por su posición. Solo se generan operaciones que
+  cumplen sus precondiciones.
+
+  Cada secuencia se decodifica de un arreglo de bytes, por lo que el mismo
+  código sirve como objetivo de libFuzzer:
+    clang++ -g -O1 -fsanitize=fuzzer,address -DLIBFUZZER -Iinclude \
+      test/diferencial.cpp src/utils.cpp src/salida.cpp ... -o fuzzer
+  Sin LIBFUZZER se compila un programa que genera los bytes con una semilla.
+
+  Ante una diferencia imprime los comandos ejecutados, con la sintaxis del
+  intérprete, y termina con 'abort'.
+
+  Uso:
+    diferencial [--iteraciones N] [--semilla S] [--bytes N]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/cadena.h"
+#include "../include/info.h"
+#include "../include/salida.h"
+#include "../include/usoTads.h"
+#include "../include/utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Cantidad máxima de elementos: las verificaciones de cada paso son O(n).
+#define MAX_ELEMENTOS 200
+// Cantidad de valores distintos de los naturales, chica para que se repitan
+// y las búsquedas encuentren.
+#define CANT_NATURALES 16
+
+typedef std::vector<std::pair<nat, double>> TModelo;
+
+struct estado {
+  const uint8_t *datos;
+  size_t largo;
+  size_t leidos;
+
+  TCadena cad;
+  TLocalizador loc;
+  TModelo modelo;
+  int pos; // posición de 'loc' en 'modelo', o -1 si no es válido
+  TBufferSalida guion; // comandos ejecutados
+};
+
+/*
+  Devuelve el siguiente byte de la entrada, o 0 si se terminó.
+*/
+static nat byte(estado &e) {
+  return (e.leidos < e.largo) ? e.datos[e.leidos++] : 0;
+}
+
+/*
+  Devuelve un número entre 0 y 'cota' - 1 leído de la entrada.
+*/
+static nat elegir(estado &e, nat cota) {
+  nat bajo = byte(e);
+  return (bajo | (byte(e) << 8)) % cota;
+}
+
+static std::pair<nat, double> elegirPar(estado &e) {
+  // los reales son múltiplos de 1/4, que se imprimen con 2 decimales exactos
+  return std::make_pair(elegir(e, CANT_NATURALES), elegir(e, 400) / 4.0);
+}
+
+static TInfo aInfo(const std::pair<nat, double> &p) {
+  return crearInfo(p.first, p.second);
+}
+
+static void agregarPar(const std::pair<nat, double> &p, TBufferSalida buf) {
+  agregarFormato(buf, "(%u,%.2f)", p.first, p.second);
+}
+
+static void agregarModelo(const TModelo &m, TBufferSalida buf) {
+  for (const auto &p : m)
+    agregarPar(p, buf);
+}
+
+/*
+  Agrega 'm' con el formato en que el intérprete lee las cadenas: la cantidad
+  de elementos y cada elemento seguido de un espacio.
+*/
+static void agregarCadenaGuion(const TModelo &m, TBufferSalida buf) {
+  agregarFormato(buf, "%zu ", m.size());
+  for (const auto &p : m) {
+    agregarPar(p, buf);
+    agregarCaracter(' ', buf);
+  }
+}
+
+static TCadena aCadena(const TModelo &m) {
+  TCadena res = crearCadena();
+  for (const auto &p : m)
+    insertarAlFinal(aInfo(p), res);
+  return res;
+}
+
+/*
+  Imprime el guion ejecutado y termina con 'abort'.
+*/
+static void fallar(estado &e, const char *que) {
+  fprintf(stderr, "---- Diferencia en %s después de: ----\n%.*s", que,
+          (int)largoBufferSalida(e.guion), textoBufferSalida(e.guion));
+  abort();
+}
+
+static void verificar(estado &e, bool condicion, const char *que) {
+  if (!condicion)
+    fallar(e, que);
+}
+
+/*
+  Verifica que 'cad' se imprima como 'm'.
+*/
+static void verificarTexto(estado &e, TCadena cad, const TModelo &m,
+                           const char *que) {
+  TBufferSalida obtenido = crearBufferSalida(64);
+  TBufferSalida esperado = crearBufferSalida(64);
+  imprimirCadenaEnBuffer(obtenido, cad);
+  agregarModelo(m, esperado);
+  agregarCaracter('\n', esperado);
+  bool iguales =
+      (largoBufferSalida(obtenido) == largoBufferSalida(esperado)) &&
+      !memcmp(textoBufferSalida(obtenido), textoBufferSalida(esperado),
+              largoBufferSalida(esperado));
+  if (!iguales)
+    fprintf(stderr, "obtenido: %.*sesperado: %.*s",
+            (int)largoBufferSalida(obtenido), textoBufferSalida(obtenido),
+            (int)largoBufferSalida(esperado), textoBufferSalida(esperado));
+  liberarBufferSalida(obtenido);
+  liberarBufferSalida(esperado);
+  verificar(e, iguales, que);
+}
+
+static bool ordenado(const TModelo &m) {
+  bool res = true;
+  for (size_t i = 1; res && (i < m.size()); i++)
+    res = m[i - 1].first <= m[i].first;
+  return res;
+}
+
+/*
+  Verifica el estado completo: el texto, el recorrido hacia atrás con
+  'anterior' y la posición de 'loc'.
+*/
+static void verificarEstado(estado &e) {
+  verificarTexto(e, e.cad, e.modelo, "el texto de cad");
+  verificar(e, esVaciaCadena(e.cad) == e.modelo.empty(), "esVaciaCadena");
+  TLocalizador cursor = finalCadena(e.cad);
+  for (size_t i = e.modelo.size(); i > 0; i--) {
+    verificar(e, esLocalizador(cursor), "el recorrido con anterior");
+    TInfo info = infoCadena(cursor, e.cad);
+    verificar(e,
+              (natInfo(info) == e.modelo[i - 1].first) &&
+                  (realInfo(info) == e.modelo[i - 1].second),
+              "el recorrido con anterior");
+    cursor = anterior(cursor, e.cad);
+  }
+  verificar(e, !esLocalizador(cursor), "el recorrido con anterior");
+  if (e.pos >= 0)
+    verificar(e, e.loc == kesimo(e.pos + 1, e.cad), "la posición de loc");
+  else
+    verificar(e, !esLocalizador(e.loc), "la posición de loc");
+  verificar(e, !estaIndexada(e.cad) || ordenado(e.modelo), "estaIndexada");
+}
+
+static int buscarAdelante(const TModelo &m, int desde, nat clave) {
+  int res = -1;
+  for (int i = desde; (res < 0) && (i < (int)m.size()); i++)
+    if (m[i].first == clave)
+      res = i;
+  return res;
+}
+
+static int buscarAtras(const TModelo &m, int desde, nat clave) {
+  int res = -1;
+  for (int i = desde; (res < 0) && (i >= 0); i--)
+    if (m[i].first == clave)
+      res = i;
+  return res;
+}
+
+/*
+  Devuelve la posición del primer elemento de 'm' cuyo natural es mayor o
+  igual a 'clave' (o mayor si 'estricta'), o 'm.size()' si no hay.
+*/
+static int cota(const TModelo &m, nat clave, bool estricta) {
+  int res = 0;
+  while ((res < (int)m.size()) &&
+         ((m[res].first < clave) || (estricta && (m[res].first == clave))))
+    res++;
+  return res;
+}
+
+/*
+  Devuelve 'true' si y solo si algún elemento de 'm' tiene natural 'clave'.
+*/
+static bool tieneClave(const TModelo &m, nat clave) {
+  return std::any_of(m.begin(), m.end(),
+                     [clave](const std::pair<nat, double> &p) {
+                       return p.first == clave;
+                     });
+}
+
+/*
+  Devuelve 'true' si y solo si el real de 'info' es mayor o igual al real al
+  que apunta 'contexto'.
+*/
+static bool superaUmbral(TInfo info, void *contexto) {
+  return realInfo(info) >= *(double *)contexto;
+}
+
+static bool repetidos(const TModelo &m) {
+  std::vector<bool> vistos(CANT_NATURALES, false);
+  bool res = false;
+  for (size_t i = 0; !res && (i < m.size()); i++) {
+    res = vistos[m[i].first];
+    vistos[m[i].first] = true;
+  }
+  return res;
+}
+
+/*
+  Elige 'k1' <= 'k2' entre 1 y la cantidad de elementos, que no es 0.
+*/
+static void elegirRango(estado &e, nat &k1, nat &k2) {
+  nat n = e.modelo.size();
+  k1 = 1 + elegir(e, n);
+  k2 = k1 + elegir(e, n - k1 + 1);
+}
+
+/*
+  Ejecuta una operación elegida con la entrada, sobre la cadena y sobre el
+  modelo, y compara sus resultados.
+*/
+static void paso(estado &e) {
+  TModelo &m = e.modelo;
+  int n = m.size();
+  bool lleno = n >= MAX_ELEMENTOS;
+  bool valido = e.pos >= 0;
+  switch (elegir(e, 37)) {
+  case 0:
+    if (!lleno) {
+      std::pair<nat, double> p = elegirPar(e);
+      agregarFormato(e.guion, "insertarAlFinal ");
+      agregarPar(p, e.guion);
+      agregarCaracter('\n', e.guion);
+      e.cad = insertarAlFinal(aInfo(p), e.cad);
+      m.push_back(p);
+    }
+    break;
+  case 1:
+    if (!lleno && valido) {
+      std::pair<nat, double> p = elegirPar(e);
+      agregarFormato(e.guion, "insertarAntes ");
+      agregarPar(p, e.guion);
+      agregarCaracter('\n', e.guion);
+      e.cad = insertarAntes(aInfo(p), e.loc, e.cad);
+      m.insert(m.begin() + e.pos, p);
+      e.pos++;
+    }
+    break;
+  case 2:
+    if (valido) {
+      agregarFormato(e.guion, "removerDeCadena\n");
+      e.cad = removerDeCadena(e.loc, e.cad);
+      m.erase(m.begin() + e.pos);
+      e.loc = NULL;
+      e.pos = -1;
+    }
+    break;
+  case 3:
+    agregarFormato(e.guion, "inicioCadena\n");
+    e.loc = inicioCadena(e.cad);
+    e.pos = (n > 0) ? 0 : -1;
+    break;
+  case 4:
+    agregarFormato(e.guion, "finalCadena\n");
+    e.loc = finalCadena(e.cad);
+    e.pos = n - 1;
+    break;
+  case 5:
+    if (valido) {
+      agregarFormato(e.guion, "siguiente\n");
+      e.loc = siguiente(e.loc, e.cad);
+      e.pos = (e.pos + 1 < n) ? e.pos + 1 : -1;
+    }
+    break;
+  case 6:
+    if (valido) {
+      agregarFormato(e.guion, "anterior\n");
+      e.loc = anterior(e.loc, e.cad);
+      e.pos--;
+    }
+    break;
+  case 7:
+    agregarFormato(e.guion, "esFinalCadena\nesInicioCadena\nesLocalizador\n");
+    verificar(e, esFinalCadena(e.loc, e.cad) == (valido && (e.pos == n - 1)),
+              "esFinalCadena");
+    verificar(e, esInicioCadena(e.loc, e.cad) == (valido && (e.pos == 0)),
+              "esInicioCadena");
+    verificar(e, esLocalizador(e.loc) == valido, "esLocalizador");
+    break;
+  case 8:
+    if (valido) {
+      agregarFormato(e.guion, "infoCadena\n");
+      TInfo info = infoCadena(e.loc, e.cad);
+      verificar(e,
+                (natInfo(info) == m[e.pos].first) &&
+                    (realInfo(info) == m[e.pos].second),
+                "infoCadena");
+    }
+    break;
+  case 9: {
+    nat k = elegir(e, n + 2);
+    agregarFormato(e.guion, "kesimo %u\n", k);
+    e.loc = kesimo(k, e.cad);
+    e.pos = ((1 <= k) && ((int)k <= n)) ? (int)k - 1 : -1;
+    break;
+  }
+  case 10: {
+    agregarFormato(e.guion, "localizadorEnCadena\n");
+    verificar(e, localizadorEnCadena(e.loc, e.cad) == valido,
+              "localizadorEnCadena");
+    nat k = elegir(e, n + 2);
+    agregarFormato(e.guion, "precedeEnCadena %u\n", k);
+    bool esperado = (1 <= k) && ((int)k <= n) && valido && ((int)k - 1 <= e.pos);
+    verificar(e, precedeEnCadena(kesimo(k, e.cad), e.loc, e.cad) == esperado,
+              "precedeEnCadena");
+    break;
+  }
+  case 11:
+    if ((n == 0) || valido) {
+      nat cant = elegir(e, 8);
+      TModelo sgm;
+      for (nat i = 0; (i < cant) && (n + i < MAX_ELEMENTOS); i++)
+        sgm.push_back(elegirPar(e));
+      agregarFormato(e.guion, "insertarSegmentoDespues ");
+      agregarCadenaGuion(sgm, e.guion);
+      agregarCaracter('\n', e.guion);
+      e.cad = insertarSegmentoDespues(aCadena(sgm), e.loc, e.cad);
+      m.insert(m.begin() + e.pos + 1, sgm.begin(), sgm.end());
+    }
+    break;
+  case 12:
+    if (n > 0) {
+      nat k1, k2;
+      elegirRango(e, k1, k2);
+      agregarFormato(e.guion, "copiarSegmento %u %u\n", k1, k2);
+      TCadena sgm = copiarSegmento(kesimo(k1, e.cad), kesimo(k2, e.cad), e.cad);
+      verificarTexto(e, sgm, TModelo(m.begin() + k1 - 1, m.begin() + k2),
+                     "copiarSegmento");
+      liberarCadena(sgm);
+    }
+    break;
+  case 13:
+    if (n > 0) {
+      nat k1, k2;
+      elegirRango(e, k1, k2);
+      agregarFormato(e.guion, "borrarSegmento %u %u\n", k1, k2);
+      e.cad = borrarSegmento(kesimo(k1, e.cad), kesimo(k2, e.cad), e.cad);
+      m.erase(m.begin() + k1 - 1, m.begin() + k2);
+      if ((e.pos >= (int)k1 - 1) && (e.pos <= (int)k2 - 1)) {
+        e.loc = NULL;
+        e.pos = -1;
+      } else if (e.pos > (int)k2 - 1) {
+        e.pos -= k2 - k1 + 1;
+      }
+    }
+    break;
+  case 14:
+    if (valido) {
+      std::pair<nat, double> p = elegirPar(e);
+      agregarFormato(e.guion, "cambiarEnCadena ");
+      agregarPar(p, e.guion);
+      agregarCaracter('\n', e.guion);
+      TInfo anteriorInfo = infoCadena(e.loc, e.cad);
+      e.cad = cambiarEnCadena(aInfo(p), e.loc, e.cad);
+      liberarInfo(anteriorInfo);
+      m[e.pos] = p;
+    }
+    break;
+  case 15:
+    if (n > 0) {
+      nat k1 = 1 + elegir(e, n), k2 = 1 + elegir(e, n);
+      agregarFormato(e.guion, "intercambiar %u %u\n", k1, k2);
+      e.cad = intercambiar(kesimo(k1, e.cad), kesimo(k2, e.cad), e.cad);
+      std::swap(m[k1 - 1], m[k2 - 1]);
+    }
+    break;
+  case 16:
+  case 17:
+    if ((n == 0) || valido) {
+      bool adelante = (n == 0) || (byte(e) % 2 == 0);
+      nat clave = elegir(e, CANT_NATURALES);
+      if (adelante) {
+        agregarFormato(e.guion, "siguienteClave %u\n", clave);
+        e.loc = siguienteClave(clave, e.loc, e.cad);
+        e.pos = (n > 0) ? buscarAdelante(m, e.pos, clave) : -1;
+      } else {
+        agregarFormato(e.guion, "anteriorClave %u\n", clave);
+        e.loc = anteriorClave(clave, e.loc, e.cad);
+        e.pos = buscarAtras(m, e.pos, clave);
+      }
+    }
+    break;
+  case 18:
+    if (valido) {
+      agregarFormato(e.guion, "menorEnCadena\n");
+      e.loc = menorEnCadena(e.loc, e.cad);
+      int menor = e.pos;
+      for (int i = e.pos + 1; i < n; i++)
+        if (m[i].first < m[menor].first)
+          menor = i;
+      e.pos = menor;
+    }
+    break;
+  case 19: {
+    nat clave = elegir(e, CANT_NATURALES);
+    agregarFormato(e.guion, "pertenece %u\nlongitud\n", clave);
+    verificar(e, pertenece(clave, e.cad) == (buscarAdelante(m, 0, clave) >= 0),
+              "pertenece");
+    verificar(e, longitud(e.cad) == (nat)n, "longitud");
+    break;
+  }
+  case 20:
+    agregarFormato(e.guion, "estaOrdenadaPorNaturales\nhayNatsRepetidos\n");
+    verificar(e, estaOrdenadaPorNaturales(e.cad) == ordenado(m),
+              "estaOrdenadaPorNaturales");
+    verificar(e, hayNatsRepetidos(e.cad) == repetidos(m), "hayNatsRepetidos");
+    break;
+  case 21:
+  case 22: {
+    // otra cadena igual a 'cad', con un cambio o con un elemento de más
+    TModelo otro = m;
+    nat cambio = byte(e) % 3;
+    if ((cambio == 1) && (n > 0))
+      otro[elegir(e, n)] = elegirPar(e);
+    else if (cambio == 2)
+      otro.push_back(elegirPar(e));
+    TCadena otra = aCadena(otro);
+    agregarFormato(e.guion, "sonIgualesCadena ");
+    agregarCadenaGuion(otro, e.guion);
+    agregarFormato(e.guion, "\nconcatenar ");
+    agregarCadenaGuion(otro, e.guion);
+    agregarCaracter('\n', e.guion);
+    verificar(e, sonIgualesCadena(e.cad, otra) == (otro == m),
+              "sonIgualesCadena");
+    TCadena conc = concatenar(e.cad, otra);
+    TModelo esperado = m;
+    esperado.insert(esperado.end(), otro.begin(), otro.end());
+    verificarTexto(e, conc, esperado, "concatenar");
+    liberarCadena(conc);
+    liberarCadena(otra);
+    break;
+  }
+  case 23:
+    if (!repetidos(m)) {
+      agregarFormato(e.guion, "ordenar\n");
+      e.cad = ordenar(e.cad);
+      // los nodos no se mueven: 'loc' queda en la misma posición
+      std::stable_sort(m.begin(), m.end(),
+                       [](const std::pair<nat, double> &a,
+                          const std::pair<nat, double> &b) {
+                         return a.first < b.first;
+                       });
+    }
+    break;
+  case 24: {
+    nat original = elegir(e, CANT_NATURALES), nuevo = elegir(e, CANT_NATURALES);
+    agregarFormato(e.guion, "cambiarTodos %u %u\n", original, nuevo);
+    e.cad = cambiarTodos(original, nuevo, e.cad);
+    for (auto &p : m)
+      if (p.first == original)
+        p.first = nuevo;
+    // 'cambiarTodos' sustituye los 'TInfo' pero no los nodos
+    break;
+  }
+  case 25:
+    if ((n > 0) && ordenado(m)) {
+      nat i = elegir(e, n), j = elegir(e, n);
+      nat menor = m[std::min(i, j)].first, mayor = m[std::max(i, j)].first;
+      agregarFormato(e.guion, "subCadena %u %u\n", menor, mayor);
+      TModelo esperado;
+      for (const auto &p : m)
+        if ((menor <= p.first) && (p.first <= mayor))
+          esperado.push_back(p);
+      TCadena sub = subCadena(menor, mayor, e.cad);
+      verificarTexto(e, sub, esperado, "subCadena");
+      liberarCadena(sub);
+    }
+    break;
+  case 26:
+    // poco frecuente para que las cadenas crezcan
+    if (byte(e) % 8 == 0) {
+      agregarFormato(e.guion, "reiniciar\n");
+      liberarCadena(e.cad);
+      e.cad = crearCadena();
+      e.loc = NULL;
+      m.clear();
+      e.pos = -1;
+    }
+    break;
+  case 27:
+    if (ordenado(m)) {
+      agregarFormato(e.guion, "indexarCadena\n");
+      e.cad = indexarCadena(e.cad);
+    }
+    break;
+  case 28:
+    if (ordenado(m)) {
+      nat clave = elegir(e, CANT_NATURALES + 1);
+      nat operacion = byte(e) % 5;
+      if ((operacion == 0) && !lleno) {
+        std::pair<nat, double> p = elegirPar(e);
+        agregarFormato(e.guion, "insertarOrdenado ");
+        agregarPar(p, e.guion);
+        agregarCaracter('\n', e.guion);
+        e.cad = insertarOrdenado(aInfo(p), e.cad);
+        int donde = cota(m, p.first, true);
+        m.insert(m.begin() + donde, p);
+        if (e.pos >= donde)
+          e.pos++;
+      } else if (operacion == 1) {
+        agregarFormato(e.guion, "buscarClave %u\n", clave);
+        e.loc = buscarClave(clave, e.cad);
+        e.pos = buscarAdelante(m, 0, clave);
+      } else if (operacion == 4) {
+        // desde 'loc', que puede no ser válido
+        agregarFormato(e.guion, "galoparClave %u\n", clave);
+        e.loc = galoparClave(clave, e.loc, e.cad);
+        if (e.pos >= 0) {
+          e.pos += cota(TModelo(m.begin() + e.pos, m.end()), clave, false);
+          if (e.pos == n)
+            e.pos = -1;
+        }
+      } else {
+        bool estricta = operacion == 3;
+        agregarFormato(e.guion, "%s %u\n",
+                       estricta ? "cotaSuperior" : "cotaInferior", clave);
+        e.loc = estricta ? cotaSuperior(clave, e.cad) : cotaInferior(clave, e.cad);
+        e.pos = cota(m, clave, estricta);
+        if (e.pos == n)
+          e.pos = -1;
+      }
+    }
+    break;
+  case 29: {
+    nat menor = elegir(e, CANT_NATURALES + 1);
+    nat mayor = menor + elegir(e, CANT_NATURALES + 1);
+    agregarFormato(e.guion, "contarEnRango %u %u\nsumaReales %u %u\n", menor,
+                   mayor, menor, mayor);
+    nat cantidad = 0;
+    double suma = 0, minimo = 0, maximo = 0;
+    for (const auto &p : m)
+      if ((menor <= p.first) && (p.first <= mayor)) {
+        if ((cantidad == 0) || (p.second < minimo))
+          minimo = p.second;
+        if ((cantidad == 0) || (p.second > maximo))
+          maximo = p.second;
+        cantidad++;
+        suma += p.second;
+      }
+    verificar(e, contarEnRango(menor, mayor, e.cad) == cantidad,
+              "contarEnRango");
+    // los reales son múltiplos de 1/4 y las sumas son exactas
+    verificar(e, sumaReales(menor, mayor, e.cad) == suma, "sumaReales");
+    if (cantidad > 0) {
+      agregarFormato(e.guion, "minReal %u %u\nmaxReal %u %u\n", menor, mayor,
+                     menor, mayor);
+      verificar(e, minReal(menor, mayor, e.cad) == minimo, "minReal");
+      verificar(e, maxReal(menor, mayor, e.cad) == maximo, "maxReal");
+    }
+    break;
+  }
+  case 30:
+    if (ordenado(m)) {
+      nat cant = elegir(e, 24);
+      TModelo otro;
+      for (nat i = 0; (i < cant) && (n + i < MAX_ELEMENTOS); i++)
+        otro.push_back(elegirPar(e));
+      std::stable_sort(otro.begin(), otro.end(),
+                       [](const std::pair<nat, double> &a,
+                          const std::pair<nat, double> &b) {
+                         return a.first < b.first;
+                       });
+      agregarFormato(e.guion, "mezclar ");
+      agregarCadenaGuion(otro, e.guion);
+      agregarCaracter('\n', e.guion);
+      e.cad = mezclar(e.cad, aCadena(otro));
+      // 'loc' queda en su nodo, después de los de 'otro' de menor natural
+      if (valido) {
+        nat clave = m[e.pos].first;
+        for (const auto &p : otro)
+          if (p.first < clave)
+            e.pos++;
+      }
+      TModelo mezcla;
+      std::merge(m.begin(), m.end(), otro.begin(), otro.end(),
+                 std::back_inserter(mezcla),
+                 [](const std::pair<nat, double> &a,
+                    const std::pair<nat, double> &b) {
+                   return a.first < b.first;
+                 });
+      m = mezcla;
+    }
+    break;
+  case 31:
+    if (ordenado(m)) {
+      static const char *nombres[] = {
+          "unionCadenas",  "interseccionCadenas", "diferenciaCadenas",
+          "unirCadenas",   "intersecarCadenas",   "restarCadenas"};
+      nat op = elegir(e, 6);
+      nat cant = elegir(e, 24);
+      TModelo otro;
+      for (nat i = 0; (i < cant) && (n + i < MAX_ELEMENTOS); i++)
+        otro.push_back(elegirPar(e));
+      std::stable_sort(otro.begin(), otro.end(),
+                       [](const std::pair<nat, double> &a,
+                          const std::pair<nat, double> &b) {
+                         return a.first < b.first;
+                       });
+      bool indexar = elegir(e, 2);
+      agregarFormato(e.guion, "%s ", nombres[op]);
+      agregarCadenaGuion(otro, e.guion);
+      agregarFormato(e.guion, indexar ? "(indexada)\n" : "\n");
+      // en la unión quedan los de 'otro' con naturales que no están en 'm';
+      // en las demás, los de 'm' con naturales en 'otro' o fuera de 'otro'
+      TModelo esperado, agregados;
+      std::vector<bool> quedan(m.size(), true);
+      if (op % 3 == 0) {
+        for (const auto &p : otro)
+          if (!tieneClave(m, p.first))
+            agregados.push_back(p);
+        std::merge(m.begin(), m.end(), agregados.begin(), agregados.end(),
+                   std::back_inserter(esperado),
+                   [](const std::pair<nat, double> &a,
+                      const std::pair<nat, double> &b) {
+                     return a.first < b.first;
+                   });
+      } else {
+        for (size_t i = 0; i < m.size(); i++) {
+          quedan[i] = tieneClave(otro, m[i].first) == (op % 3 == 1);
+          if (quedan[i])
+            esperado.push_back(m[i]);
+        }
+      }
+      TCadena c2 = aCadena(otro);
+      if (indexar)
+        indexarCadena(c2);
+      if (op < 3) {
+        TCadena res;
+        if (op == 0)
+          res = unionCadenas(e.cad, c2);
+        else if (op == 1)
+          res = interseccionCadenas(e.cad, c2);
+        else
+          res = diferenciaCadenas(e.cad, c2);
+        verificarTexto(e, res, esperado, nombres[op]);
+        verificarTexto(e, c2, otro, nombres[op]);
+        liberarCadena(res);
+        liberarCadena(c2);
+      } else {
+        if (op == 3)
+          e.cad = unirCadenas(e.cad, c2);
+        else if (op == 4)
+          e.cad = intersecarCadenas(e.cad, c2);
+        else
+          e.cad = restarCadenas(e.cad, c2);
+        if (valido && !quedan[e.pos]) {
+          e.loc = NULL;
+          e.pos = -1;
+        } else if (valido) {
+          // 'loc' queda en su nodo
+          int pos = 0;
+          for (int i = 0; i < e.pos; i++)
+            pos += quedan[i];
+          for (const auto &p : agregados)
+            if (p.first < m[e.pos].first)
+              pos++;
+          e.pos = pos;
+        }
+        m = esperado;
+      }
+    }
+    break;
+  case 32: {
+    bool primera = elegir(e, 2);
+    agregarFormato(e.guion, "eliminarRepetidos %s\n",
+                   primera ? "primera" : "ultima");
+    e.cad = eliminarRepetidos(e.cad,
+                              primera ? primeraOcurrencia : ultimaOcurrencia);
+    std::vector<bool> vistos(CANT_NATURALES, false), quedan(n);
+    for (int k = 0; k < n; k++) {
+      int i = primera ? k : n - 1 - k;
+      quedan[i] = !vistos[m[i].first];
+      vistos[m[i].first] = true;
+    }
+    TModelo resto;
+    int pos = -1;
+    for (int i = 0; i < n; i++)
+      if (quedan[i]) {
+        if (i == e.pos)
+          pos = resto.size();
+        resto.push_back(m[i]);
+      }
+    if (pos < 0)
+      e.loc = NULL;
+    e.pos = pos;
+    m = resto;
+    verificar(e, !hayNatsRepetidos(e.cad), "hayNatsRepetidos");
+    break;
+  }
+  case 33: {
+    // 0 y 1 filtran o particionan por el real, 2 y 3 por un rango de naturales
+    nat op = elegir(e, 4);
+    double umbral = elegir(e, 400) / 4.0;
+    nat menor = elegir(e, CANT_NATURALES + 1);
+    nat mayor = menor + elegir(e, CANT_NATURALES / 2);
+    std::vector<bool> quedan(n);
+    TModelo resto, otros;
+    for (int i = 0; i < n; i++) {
+      quedan[i] = (op < 2) ? (m[i].second >= umbral)
+                           : ((menor <= m[i].first) && (m[i].first <= mayor));
+      (quedan[i] ? resto : otros).push_back(m[i]);
+    }
+    TCadena res = NULL;
+    if (op == 0) {
+      agregarFormato(e.guion, "filtrarCadena >= %.2f\n", umbral);
+      e.cad = filtrarCadena(e.cad, superaUmbral, &umbral);
+    } else if (op == 1) {
+      agregarFormato(e.guion, "particionarCadena >= %.2f\n", umbral);
+      res = particionarCadena(e.cad, superaUmbral, &umbral);
+    } else if (op == 2) {
+      agregarFormato(e.guion, "filtrarRango %u %u\n", menor, mayor);
+      e.cad = filtrarRango(menor, mayor, e.cad);
+    } else {
+      agregarFormato(e.guion, "particionarRango %u %u\n", menor, mayor);
+      res = particionarRango(menor, mayor, e.cad);
+    }
+    if (res != NULL) {
+      verificarTexto(e, res, otros, "el resultado de particionar");
+      liberarCadena(res);
+    }
+    // 'loc' queda en su nodo si sigue en 'cad'
+    if (valido && !quedan[e.pos]) {
+      e.loc = NULL;
+      e.pos = -1;
+    } else if (valido) {
+      e.pos = std::count(quedan.begin(), quedan.begin() + e.pos, true);
+    }
+    m = resto;
+    break;
+  }
+  case 34:
+    if (elegir(e, 2)) {
+      agregarFormato(e.guion, "invertirCadena\n");
+      e.cad = invertirCadena(e.cad);
+      std::reverse(m.begin(), m.end());
+      if (valido)
+        e.pos = n - 1 - e.pos;
+    } else {
+      agregarFormato(e.guion, "normalizar\n");
+      e.cad = normalizar(e.cad);
+    }
+    break;
+  case 35:
+    if (valido) {
+      agregarFormato(e.guion, "partirCadena\n");
+      bool indexada = estaIndexada(e.cad);
+      // un localizador de la cola sigue accediendo a su elemento
+      nat k = e.pos + 2 + elegir(e, n);
+      TLocalizador enCola = kesimo(k, e.cad);
+      TCadena res = partirCadena(e.loc, e.cad);
+      verificarTexto(e, res, TModelo(m.begin() + e.pos + 1, m.end()),
+                     "el resultado de partirCadena");
+      if ((int)k <= n)
+        verificar(e, localizadorEnCadena(enCola, res) &&
+                         (natInfo(infoCadena(enCola, res)) == m[k - 1].first),
+                  "un localizador de la cola de partirCadena");
+      verificar(e, estaIndexada(res) == indexada,
+                "estaIndexada del resultado de partirCadena");
+      // se vuelve a unir o se descarta la cola
+      if (elegir(e, 2)) {
+        agregarFormato(e.guion, "insertarSegmentoDespues\n");
+        e.cad = insertarSegmentoDespues(res, e.loc, e.cad);
+      } else {
+        liberarCadena(res);
+        m.erase(m.begin() + e.pos + 1, m.end());
+      }
+    }
+    break;
+  case 36:
+    if (n > 0) {
+      nat k1, k2;
+      elegirRango(e, k1, k2);
+      int cant = k2 - k1 + 1;
+      if ((cant < n) && elegir(e, 2)) {
+        // a otro lugar de 'cad', después del elemento 'k' que queda, o al
+        // inicio si 'k' es 0
+        nat k = elegir(e, n - cant + 1);
+        if (k >= k1)
+          k += cant;
+        agregarFormato(e.guion, "moverSegmento %u %u %u\n", k1, k2, k);
+        TLocalizador destinoLoc = (k == 0) ? NULL : kesimo(k, e.cad);
+        e.cad = moverSegmento(kesimo(k1, e.cad), kesimo(k2, e.cad), e.cad,
+                              destinoLoc, e.cad);
+        // se mueven también las posiciones, para seguir a 'loc'
+        std::vector<int> orden(n);
+        for (int i = 0; i < n; i++)
+          orden[i] = i;
+        int despues = (k == 0) ? 0 : (int)k - ((k > k2) ? cant : 0);
+        std::vector<int> movidas(orden.begin() + k1 - 1, orden.begin() + k2);
+        orden.erase(orden.begin() + k1 - 1, orden.begin() + k2);
+        orden.insert(orden.begin() + despues, movidas.begin(), movidas.end());
+        TModelo nuevo;
+        int pos = -1;
+        for (int i = 0; i < n; i++) {
+          nuevo.push_back(m[orden[i]]);
+          if (orden[i] == e.pos)
+            pos = i;
+        }
+        e.pos = pos;
+        m = nuevo;
+      } else {
+        // a otra cadena, que puede estar invertida
+        nat largo = elegir(e, 8);
+        TModelo otro;
+        for (nat i = 0; i < largo; i++)
+          otro.push_back(elegirPar(e));
+        bool invertida = elegir(e, 2);
+        nat k = elegir(e, largo + 1);
+        agregarFormato(e.guion, "moverSegmento %u %u a %u%s ", k1, k2, k,
+                       invertida ? " (invertida)" : "");
+        agregarCadenaGuion(otro, e.guion);
+        agregarCaracter('\n', e.guion);
+        TCadena otra = aCadena(otro);
+        if (invertida) {
+          otra = invertirCadena(otra);
+          std::reverse(otro.begin(), otro.end());
+        }
+        TLocalizador destinoLoc = (k == 0) ? NULL : kesimo(k, otra);
+        otra = moverSegmento(kesimo(k1, e.cad), kesimo(k2, e.cad), e.cad,
+                             destinoLoc, otra);
+        otro.insert(otro.begin() + k, m.begin() + k1 - 1, m.begin() + k2);
+        verificarTexto(e, otra, otro, "el destino de moverSegmento");
+        bool movido = valido && ((int)k1 - 1 <= e.pos) && (e.pos < (int)k2);
+        if (movido)
+          verificar(e, localizadorEnCadena(e.loc, otra) &&
+                           (natInfo(infoCadena(e.loc, otra)) ==
+                            m[e.pos].first),
+                    "loc en el destino de moverSegmento");
+        liberarCadena(otra);
+        m.erase(m.begin() + k1 - 1, m.begin() + k2);
+        if (movido) {
+          // 'otra' se liberó con 'loc'
+          e.loc = NULL;
+          e.pos = -1;
+        } else if (valido && (e.pos >= (int)k2)) {
+          e.pos -= cant;
+        }
+      }
+    }
+    break;
+  }
+}
+
+/*
+  Ejecuta la secuencia de operaciones codificada en los 'largo' bytes de
+  'datos'.
+*/
+static void ejecutarSecuencia(const uint8_t *datos, size_t largo) {
+  estado e;
+  e.datos = datos;
+  e.largo = largo;
+  e.leidos = 0;
+  e.cad = crearCadena();
+  e.loc = NULL;
+  e.pos = -1;
+  e.guion = crearBufferSalida(256);
+  while (e.leidos < e.largo) {
+    paso(e);
+    verificarEstado(e);
+  }
+  liberarCadena(e.cad);
+  liberarBufferSalida(e.guion);
+}
+
+#ifdef LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *datos, size_t largo) {
+  ejecutarSecuencia(datos, largo);
+  return 0;
+}
+
+#else
+
+int main(int argc, char *argv[]) {
+  nat iteraciones = 2000, semilla = 1, bytes = 4000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iteraciones") && (i + 1 < argc)) {
+      iteraciones = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--semilla") && (i + 1 < argc)) {
+      semilla = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--bytes") && (i + 1 < argc)) {
+      bytes = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Uso: %s [--iteraciones N] [--semilla S] [--bytes N]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  std::vector<uint8_t> datos;
+  for (nat it = 0; it < iteraciones; it++) {
+    // el largo varía para que haya secuencias cortas y largas
+    std::mt19937 azar(semilla + it);
+    datos.resize(1 + azar() % bytes);
+    for (uint8_t &b : datos)
+      b = azar();
+    ejecutarSecuencia(datos.data(), datos.size());
+  }
+  printf("%u secuencias sin diferencias.\n", iteraciones);
+  return 0;
+}
+
+#endif
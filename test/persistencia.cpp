@@ -0,0 +1,305 @@
+/*
+  Prueba de 'persistencia'.
+
+  Guarda cadenas al azar, con y sin índice, y verifica que al abrirlas con
+  'abrirCadenaMapeada' y al cargarlas con 'cargarCadena' se obtienen los
+  mismos elementos, que 'buscarClaveMapeada' devuelve la primera posición de
+  cada natural y que 'imprimirCadenaMapeada' imprime lo mismo que
+  'imprimirCadena'.
+
+  Después daña archivos guardados (los trunca, cambia la marca, pone en el
+  cabezal valores que desbordan al sumarlos o multiplicarlos y pone en el
+  índice posiciones fuera de rango) y verifica que se rechazan al abrirlos o,
+  en el caso del índice, que las búsquedas no usan las entradas dañadas.
+
+  Termina con 'abort' ante el primer error.
+
+  Uso:
+    persistencia [--iteraciones N] [--semilla S]
+
+  Laboratorio de Programación 2.
+  InCo-FIng-UDELAR
+*/
+
+#include "../include/cadena.h"
+#include "../include/info.h"
+#include "../include/persistencia.h"
+#include "../include/utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // dup, dup2, truncate, mkstemp
+
+#include <random>
+
+// Tamaños del formato descrito en persistencia.h.
+#define TAM_CABEZAL 32
+#define TAM_REGISTRO 12
+// Desplazamientos de los campos del cabezal.
+#define POS_VERSION 4
+#define POS_CANTIDAD 16
+#define POS_INDICE 24
+
+// Los naturales de los elementos van de 1 a CANT_NATURALES, para que haya
+// repetidos.
+#define CANT_NATURALES 20
+
+static char archivo[] = "/tmp/persistenciaXXXXXX";
+static char impreso[] = "/tmp/persistenciaXXXXXX";
+static nat casos = 0;
+
+static void fallar(const char *motivo, nat semilla) {
+  fprintf(stderr, "Error (semilla %u): %s.\n", semilla, motivo);
+  abort();
+}
+
+static void verificar(bool cond, const char *motivo, nat semilla) {
+  if (!cond)
+    fallar(motivo, semilla);
+  casos++;
+}
+
+/*
+  Devuelve una cadena con 'n' elementos al azar.
+*/
+static TCadena cadenaAlAzar(nat n, std::mt19937 &azar) {
+  TCadena res = crearCadena();
+  for (nat i = 0; i < n; i++) {
+    nat clave = 1 + azar() % CANT_NATURALES;
+    res = insertarAlFinal(crearInfo(clave, (azar() % 10000) / 100.0), res);
+  }
+  return res;
+}
+
+/*
+  Escribe 'largo' bytes de 'datos' en la posición 'pos' de 'archivo'.
+*/
+static void sobrescribir(long pos, const void *datos, size_t largo) {
+  FILE *f = fopen(archivo, "r+b");
+  if ((f == NULL) || (fseek(f, pos, SEEK_SET) != 0) ||
+      (fwrite(datos, 1, largo, f) != largo) || (fclose(f) != 0)) {
+    perror(archivo);
+    abort();
+  }
+}
+
+/*
+  Devuelve en 'res' las líneas que imprimen 'imprimirCadena(cad)' y
+  'imprimirCadenaMapeada(map)', una después de la otra.
+*/
+static void capturarImpresiones(TCadena cad, TCadenaMapeada map,
+                                char *res, size_t tam) {
+  fflush(stdout);
+  int original = dup(STDOUT_FILENO);
+  if (freopen(impreso, "w", stdout) == NULL) {
+    perror(impreso);
+    abort();
+  }
+  imprimirCadena(cad);
+  imprimirCadenaMapeada(map);
+  fflush(stdout);
+  dup2(original, STDOUT_FILENO);
+  close(original);
+
+  FILE *f = fopen(impreso, "r");
+  size_t leidos = fread(res, 1, tam - 1, f);
+  res[leidos] = '\0';
+  fclose(f);
+}
+
+/*
+  Guarda una cadena al azar y verifica que se recupera igual.
+*/
+static void probarIdaYVuelta(nat n, bool conIndice, nat semilla) {
+  std::mt19937 azar(semilla);
+  TCadena cad = cadenaAlAzar(n, azar);
+  verificar(guardarCadena(archivo, conIndice, cad), "no se guardó", semilla);
+
+  TCadenaMapeada map = abrirCadenaMapeada(archivo);
+  verificar(map != NULL, "no se abrió el archivo guardado", semilla);
+  verificar(longitudMapeada(map) == n, "longitud distinta", semilla);
+  // primera posición de cada natural
+  nat primera[CANT_NATURALES + 1] = {0};
+  nat k = 1;
+  for (TLocalizador loc = inicioCadena(cad); loc != NULL;
+       loc = siguienteSinVerificar(loc, cad), k++) {
+    TInfo info = infoCadena(loc, cad);
+    verificar((natMapeado(k, map) == natInfo(info)) &&
+                  (realMapeado(k, map) == realInfo(info)),
+              "elemento mapeado distinto", semilla);
+    if (primera[natInfo(info)] == 0)
+      primera[natInfo(info)] = k;
+  }
+  for (nat c = 0; c <= CANT_NATURALES + 1; c++) {
+    nat esperada = (c <= CANT_NATURALES) ? primera[c] : 0;
+    verificar(buscarClaveMapeada(c, map) == esperada,
+              "buscarClaveMapeada no devuelve la primera posición", semilla);
+  }
+
+  char impresiones[2 * 16 * 1024];
+  capturarImpresiones(cad, map, impresiones, sizeof(impresiones));
+  char *salto = strchr(impresiones, '\n');
+  size_t largo = (salto != NULL) ? salto - impresiones + 1 : 0;
+  verificar((salto != NULL) && (strlen(salto + 1) == largo) &&
+                (strncmp(impresiones, salto + 1, largo) == 0),
+            "imprimirCadenaMapeada no imprime como imprimirCadena", semilla);
+  cerrarCadenaMapeada(map);
+
+  TCadena cargada = cargarCadena(archivo);
+  verificar(cargada != NULL, "no se cargó el archivo guardado", semilla);
+  TLocalizador a = inicioCadena(cad), b = inicioCadena(cargada);
+  while ((a != NULL) && (b != NULL) &&
+         (natInfo(infoCadena(a, cad)) == natInfo(infoCadena(b, cargada))) &&
+         (realInfo(infoCadena(a, cad)) == realInfo(infoCadena(b, cargada)))) {
+    a = siguienteSinVerificar(a, cad);
+    b = siguienteSinVerificar(b, cargada);
+  }
+  verificar((a == NULL) && (b == NULL), "cadena cargada distinta", semilla);
+  liberarCadena(cargada);
+  liberarCadena(cad);
+}
+
+/*
+  Verifica que 'abrirCadenaMapeada' y 'cargarCadena' rechazan el archivo.
+*/
+static void verificarRechazo(const char *motivo, nat semilla) {
+  TCadenaMapeada map = abrirCadenaMapeada(archivo);
+  if (map != NULL)
+    cerrarCadenaMapeada(map);
+  verificar(map == NULL, motivo, semilla);
+  TCadena cad = cargarCadena(archivo);
+  if (cad != NULL)
+    liberarCadena(cad);
+  verificar(cad == NULL, motivo, semilla);
+}
+
+/*
+  Guarda una cadena de 'n' elementos al azar en 'archivo'.
+*/
+static void guardarAlAzar(nat n, bool conIndice, nat semilla) {
+  std::mt19937 azar(semilla);
+  TCadena cad = cadenaAlAzar(n, azar);
+  if (!guardarCadena(archivo, conIndice, cad))
+    fallar("no se guardó", semilla);
+  liberarCadena(cad);
+}
+
+static void probarTruncados(nat n, nat semilla) {
+  long tamIndice = TAM_CABEZAL + (long)n * TAM_REGISTRO;
+  long cortes[] = {0, TAM_CABEZAL - 1, tamIndice - 1, tamIndice + 4 * n - 1};
+  for (long corte : cortes) {
+    guardarAlAzar(n, true, semilla);
+    if (truncate(archivo, corte) != 0) {
+      perror(archivo);
+      abort();
+    }
+    verificarRechazo("se aceptó un archivo truncado", semilla);
+  }
+}
+
+static void probarCabezalesDanados(nat n, nat semilla) {
+  guardarAlAzar(n, true, semilla);
+  sobrescribir(0, "CADA", 4);
+  verificarRechazo("se aceptó una marca errónea", semilla);
+
+  guardarAlAzar(n, true, semilla);
+  uint32_t version = VERSION_ARCHIVO_CADENA + 1;
+  sobrescribir(POS_VERSION, &version, 4);
+  verificarRechazo("se aceptó una versión desconocida", semilla);
+
+  // cantidades cuyo producto por TAM_REGISTRO, o su suma con el tamaño del
+  // cabezal, desbordan
+  uint64_t cantidades[] = {UINT64_MAX, UINT64_MAX / TAM_REGISTRO + 1,
+                           (uint64_t)UINT32_MAX + 1, (uint64_t)n + 1};
+  for (uint64_t cantidad : cantidades) {
+    guardarAlAzar(n, true, semilla);
+    sobrescribir(POS_CANTIDAD, &cantidad, 8);
+    verificarRechazo("se aceptó una cantidad desbordada", semilla);
+  }
+
+  // desplazamientos del índice fuera del archivo o que desbordan al sumarles
+  // el tamaño del índice
+  uint64_t desplazamientos[] = {UINT64_MAX - 3, UINT64_MAX - 3 - 4 * (uint64_t)n,
+                                TAM_CABEZAL, 2};
+  for (uint64_t desplazamiento : desplazamientos) {
+    guardarAlAzar(n, true, semilla);
+    sobrescribir(POS_INDICE, &desplazamiento, 8);
+    verificarRechazo("se aceptó un desplazamiento de índice erróneo", semilla);
+  }
+}
+
+/*
+  Pone posiciones fuera de rango en el índice. El archivo se sigue abriendo
+  (las entradas se validan al usarlas) y 'buscarClaveMapeada' devuelve 0 o
+  una posición con el natural buscado.
+*/
+static void probarIndiceDanado(nat n, nat semilla) {
+  std::mt19937 azar(semilla);
+  guardarAlAzar(n, true, semilla);
+  long inicioIndice = TAM_CABEZAL + (long)n * TAM_REGISTRO;
+  uint32_t fuera[] = {n, UINT32_MAX};
+  for (nat i = 0; i < 1 + n / 4; i++) {
+    uint32_t p = fuera[azar() % 2];
+    sobrescribir(inicioIndice + 4 * (azar() % n), &p, 4);
+  }
+  TCadenaMapeada map = abrirCadenaMapeada(archivo);
+  verificar(map != NULL, "no se abrió un archivo con el índice dañado",
+            semilla);
+  for (nat c = 0; c <= CANT_NATURALES + 1; c++) {
+    nat k = buscarClaveMapeada(c, map);
+    verificar((k == 0) || ((k <= n) && (natMapeado(k, map) == c)),
+              "buscarClaveMapeada usó una entrada dañada", semilla);
+  }
+  cerrarCadenaMapeada(map);
+
+  // con todas las entradas fuera de rango no se encuentra nada
+  for (nat i = 0; i < n; i++)
+    sobrescribir(inicioIndice + 4 * i, &fuera[1], 4);
+  map = abrirCadenaMapeada(archivo);
+  verificar(map != NULL, "no se abrió un archivo con el índice dañado",
+            semilla);
+  for (nat c = 0; c <= CANT_NATURALES + 1; c++)
+    verificar(buscarClaveMapeada(c, map) == 0,
+              "buscarClaveMapeada usó una entrada dañada", semilla);
+  cerrarCadenaMapeada(map);
+}
+
+int main(int argc, char *argv[]) {
+  nat iteraciones = 200, semilla = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iteraciones") && (i + 1 < argc)) {
+      iteraciones = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--semilla") && (i + 1 < argc)) {
+      semilla = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Uso: %s [--iteraciones N] [--semilla S]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  int fd1 = mkstemp(archivo), fd2 = mkstemp(impreso);
+  if ((fd1 < 0) || (fd2 < 0)) {
+    perror("mkstemp");
+    return 1;
+  }
+  close(fd1);
+  close(fd2);
+
+  probarIdaYVuelta(0, false, semilla);
+  probarIdaYVuelta(0, true, semilla);
+  for (nat i = 0; i < iteraciones; i++) {
+    nat s = semilla + i;
+    nat n = 1 + s % 300;
+    probarIdaYVuelta(n, (i % 2) == 0, s);
+    probarTruncados(n, s);
+    probarCabezalesDanados(n, s);
+    probarIndiceDanado(n, s);
+  }
+
+  unlink(archivo);
+  unlink(impreso);
+  printf("%u verificaciones sin errores.\n", casos);
+  return 0;
+}